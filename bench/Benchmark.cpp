@@ -0,0 +1,330 @@
+// maayan4282gmail.com
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SimdKernels.hpp"
+#include "SimdSort.hpp"
+#include "AdaptiveSort.hpp"
+#include "EytzingerOrder.hpp"
+#include "StaticBTree.hpp"
+#include "FrequencyOrder.hpp"
+#include "Order.hpp"
+#include "ReverseOrder.hpp"
+#include "ChunkedIteration.hpp"
+#include "Parallel.hpp"
+
+using namespace mycontainers;
+
+namespace {
+
+const char* isaName(simd::Isa isa) {
+    switch (isa) {
+        case simd::Isa::Avx512: return "avx512";
+        case simd::Isa::Avx2:   return "avx2";
+        default:                return "scalar";
+    }
+}
+
+/**
+ * @brief Runs fn `reps` times and returns the average time per call in microseconds.
+ */
+template <typename Fn>
+double timeIt(int reps, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) {
+        fn();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / reps;
+}
+
+template <typename T>
+void benchType(const std::string& typeName, size_t n, int reps) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 1000);
+    std::vector<T> source(n);
+    for (auto& v : source) {
+        v = static_cast<T>(dist(rng));
+    }
+    const T needle = static_cast<T>(500);
+
+    for (simd::Isa level : {simd::Isa::Scalar, simd::Isa::Avx2, simd::Isa::Avx512}) {
+        if (simd::setIsa(level) != level) {
+            continue;
+        }
+        volatile size_t sink = 0;
+        std::vector<T> scratch;
+
+        double removeUs = timeIt(reps, [&] {
+            scratch = source;
+            sink = sink + simd::removeValue(scratch.data(), scratch.size(), needle);
+        });
+        double minMaxUs = timeIt(reps, [&] {
+            sink = sink + static_cast<size_t>(simd::minMax(source.data(), source.size()).second);
+        });
+        double countUs = timeIt(reps, [&] {
+            sink = sink + simd::count(source.data(), source.size(), needle);
+        });
+        double containsUs = timeIt(reps, [&] {
+            sink = sink + simd::contains(source.data(), source.size(), static_cast<T>(-1));
+        });
+
+        std::cout << std::left << std::setw(8) << typeName << std::setw(8) << isaName(level)
+                  << std::fixed << std::setprecision(1)
+                  << " remove " << std::setw(10) << removeUs
+                  << " minmax " << std::setw(10) << minMaxUs
+                  << " count " << std::setw(10) << countUs
+                  << " contains " << containsUs << " (us)" << std::endl;
+    }
+}
+
+template <typename T>
+void benchSort(const std::string& typeName, size_t n, int reps) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(-100000, 100000);
+    std::vector<T> source(n);
+    for (auto& v : source) {
+        v = static_cast<T>(dist(rng));
+    }
+
+    std::vector<T> scratch;
+    double stdUs = timeIt(reps, [&] {
+        scratch = source;
+        std::sort(scratch.begin(), scratch.end());
+    });
+    double simdUs = timeIt(reps, [&] {
+        scratch = source;
+        simd::sort(scratch.data(), scratch.data() + scratch.size());
+    });
+    std::cout << std::left << std::setw(8) << typeName << "sort n=" << std::setw(8) << n
+              << std::fixed << std::setprecision(1)
+              << " std::sort " << std::setw(10) << stdUs
+              << " simd::sort " << simdUs << " (us)" << std::endl;
+}
+
+/**
+ * @brief Times std::sort and adaptiveSort on timestamps appended almost in order.
+ */
+void benchNearlySorted(size_t n, int reps) {
+    std::mt19937 rng(3);
+    std::vector<int> source(n);
+    for (size_t i = 0; i < n; ++i) {
+        source[i] = static_cast<int>(i);
+        if (rng() % 100 == 0) {
+            source[i] -= static_cast<int>(rng() % 50);
+        }
+    }
+
+    std::vector<int> scratch;
+    double stdUs = timeIt(reps, [&] {
+        scratch = source;
+        std::sort(scratch.begin(), scratch.end());
+    });
+    double adaptiveUs = timeIt(reps, [&] {
+        scratch = source;
+        adaptiveSort(scratch.data(), scratch.data() + scratch.size());
+    });
+    std::sort(source.begin(), source.end());
+    double sortedUs = timeIt(reps, [&] {
+        scratch = source;
+        adaptiveSort(scratch.data(), scratch.data() + scratch.size());
+    });
+    std::cout << "nearly sorted n=" << std::setw(8) << n << std::fixed << std::setprecision(1)
+              << " std::sort " << std::setw(10) << stdUs
+              << " adaptiveSort " << std::setw(10) << adaptiveUs
+              << " adaptiveSort(sorted) " << sortedUs << " (us)" << std::endl;
+}
+
+/**
+ * @brief Times lower_bound lookups: binary search over the sorted array vs. the Eytzinger
+ *        layout vs. the static B+ tree.
+ */
+void benchSearch(size_t n, int lookups) {
+    std::mt19937 rng(5);
+    Container<int> c;
+    for (size_t i = 0; i < n; ++i) {
+        c.add(static_cast<int>(rng() % (4 * n)));
+    }
+    c.buildSortedIndex();
+    const auto& sorted = c.getSortedIndex();
+    EytzingerOrder<int> eyt(c);
+    StaticBTree<int> tree(c);
+    std::vector<int> probes(lookups);
+    for (auto& p : probes) {
+        p = static_cast<int>(rng() % (4 * n));
+    }
+
+    volatile size_t sink = 0;
+    double binaryUs = timeIt(1, [&] {
+        for (int p : probes) {
+            sink = sink + static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), p) - sorted.begin());
+        }
+    });
+    double eytzingerUs = timeIt(1, [&] {
+        for (int p : probes) {
+            sink = sink + static_cast<size_t>(eyt.contains(p));
+        }
+    });
+    double btreeUs = timeIt(1, [&] {
+        for (int p : probes) {
+            sink = sink + tree.rank(p);
+        }
+    });
+    std::cout << "lower_bound n=" << std::setw(10) << n << std::fixed << std::setprecision(1)
+              << " binary " << std::setw(10) << binaryUs * 1000 / lookups
+              << " eytzinger " << std::setw(10) << eytzingerUs * 1000 / lookups
+              << " btree " << btreeUs * 1000 / lookups << " (ns/lookup)" << std::endl;
+}
+
+/**
+ * @brief Times contains() on absent values: a full scan vs. the Bloom filter rejection.
+ */
+void benchAbsentProbes(size_t n, int lookups) {
+    Container<int> c;
+    for (size_t i = 0; i < n; ++i) {
+        c.add(static_cast<int>(2 * i));
+    }
+    volatile size_t sink = 0;
+    double scanUs = timeIt(1, [&] {
+        for (int p = 0; p < lookups; ++p) {
+            sink = sink + static_cast<size_t>(c.contains(2 * p + 1));
+        }
+    });
+    c.buildFilter();
+    double filterUs = timeIt(1, [&] {
+        for (int p = 0; p < lookups; ++p) {
+            sink = sink + static_cast<size_t>(c.contains(2 * p + 1));
+        }
+    });
+    std::cout << "absent contains n=" << std::setw(8) << n << std::fixed << std::setprecision(1)
+              << " scan " << std::setw(10) << scanUs * 1000 / lookups
+              << " filter " << filterUs * 1000 / lookups << " (ns/lookup)" << std::endl;
+}
+
+/**
+ * @brief Times exact frequency counting: std::unordered_map vs. FrequencyOrder's open-addressing table.
+ */
+void benchFrequency(size_t n, size_t distinct) {
+    std::mt19937 rng(21);
+    Container<int> c;
+    for (size_t i = 0; i < n; ++i) {
+        c.add(static_cast<int>(rng() % distinct));
+    }
+    volatile size_t sink = 0;
+    double mapUs = timeIt(1, [&] {
+        std::unordered_map<int, size_t> counts;
+        for (int x : c.getData()) {
+            ++counts[x];
+        }
+        sink = sink + counts.size();
+    });
+    double tableUs = timeIt(1, [&] {
+        FrequencyOrder<int> f(c, 10);
+        sink = sink + f.size();
+    });
+    double approxUs = timeIt(1, [&] {
+        FrequencyOrder<int> f(c, SpaceSaving{1024});
+        sink = sink + f.size();
+    });
+    std::cout << "frequency n=" << std::setw(10) << n << " distinct=" << std::setw(8) << distinct
+              << std::fixed << std::setprecision(1)
+              << " unordered_map " << std::setw(10) << mapUs
+              << " FrequencyOrder " << std::setw(10) << tableUs
+              << " space-saving " << approxUs << " (us)" << std::endl;
+}
+
+/**
+ * @brief Times a block consumer (a SIMD count per 4096-element block) fed by filling a
+ *        buffer element by element vs. by for_each_chunk.
+ */
+template <typename View>
+void benchChunks(const char* name, const View& view, int reps) {
+    constexpr size_t block = 4096;
+    volatile size_t sink = 0;
+    double elementUs = timeIt(reps, [&] {
+        std::vector<int> buffer;
+        buffer.reserve(block);
+        size_t total = 0;
+        for (int x : view) {
+            buffer.push_back(x);
+            if (buffer.size() == block) {
+                total += simd::count(buffer.data(), buffer.size(), 7);
+                buffer.clear();
+            }
+        }
+        total += simd::count(buffer.data(), buffer.size(), 7);
+        sink = sink + total;
+    });
+    double chunkUs = timeIt(reps, [&] {
+        size_t total = 0;
+        for_each_chunk(view, block, [&](std::span<const int> chunk) {
+            total += simd::count(chunk.data(), chunk.size(), 7);
+        });
+        sink = sink + total;
+    });
+    std::cout << "blocks " << std::setw(8) << name << std::fixed << std::setprecision(1)
+              << " element-wise buffer " << std::setw(10) << elementUs
+              << " for_each_chunk " << chunkUs << " (us)" << std::endl;
+}
+
+/**
+ * @brief Times a sum over a view: a sequential loop vs. parallel_reduce on the shared pool.
+ */
+template <typename View>
+void benchParallelReduce(const char* name, const View& view, int reps) {
+    volatile long long sink = 0;
+    double sequentialUs = timeIt(reps, [&] {
+        sink = sink + std::accumulate(view.begin(), view.end(), 0LL);
+    });
+    double parallelUs = timeIt(reps, [&] {
+        sink = sink + parallel_reduce(view, 0LL);
+    });
+    std::cout << "reduce " << std::setw(8) << name << " threads=" << ThreadPool::shared().size() + 1
+              << std::fixed << std::setprecision(1)
+              << " sequential " << std::setw(10) << sequentialUs
+              << " parallel_reduce " << parallelUs << " (us)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    int reps = argc > 2 ? std::stoi(argv[2]) : 50;
+
+    std::cout << "Scan kernels over " << n << " elements, " << reps << " repetitions" << std::endl;
+    benchType<int>("int", n, reps);
+    benchType<float>("float", n, reps);
+    benchType<double>("double", n, reps);
+
+    simd::setIsa(simd::Isa::Avx512);
+    for (size_t sortSize : {size_t(256), size_t(4096), size_t(65536)}) {
+        benchSort<int>("int", sortSize, reps * 20);
+        benchSort<float>("float", sortSize, reps * 20);
+    }
+    benchNearlySorted(n, reps);
+    for (size_t searchSize : {size_t(1) << 12, size_t(1) << 20, size_t(1) << 24}) {
+        benchSearch(searchSize, 2000000);
+    }
+    benchAbsentProbes(n, 2000);
+    {
+        Container<int> c;
+        for (size_t i = 0; i < n; ++i) {
+            c.add(static_cast<int>(i * 2654435761u));
+        }
+        benchChunks("Order", Order<int>(c), reps);
+        benchChunks("Reverse", ReverseOrder<int>(c), reps);
+        benchParallelReduce("Order", Order<int>(c), reps);
+        benchParallelReduce("Reverse", ReverseOrder<int>(c), reps);
+    }
+    for (size_t distinct : {size_t(1000), size_t(1) << 20}) {
+        benchFrequency(4 * n, distinct);
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_ADAPTIVE_SORT_HPP
+#define MYCONTAINERS_ADAPTIVE_SORT_HPP
+
+#include "SimdSort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * @brief Minimum average run length for which merging the detected runs beats a full sort.
+ */
+constexpr size_t adaptiveMinAverageRun = 32;
+
+/**
+ * @brief Inputs of at most this many elements are sorted directly, skipping run
+ *        detection and its allocation (insertion sort is already linear on sorted input).
+ */
+constexpr size_t adaptiveSmallInput = 16;
+
+/**
+ * @brief Splits [first, last) into maximal sorted runs with respect to comp.
+ *
+ * A run is either non-decreasing or strictly decreasing; strictly decreasing
+ * runs are reversed in place, which keeps equal elements in their original order.
+ *
+ * @return std::vector<size_t> Run boundaries: 0, end of run 1, ..., last - first.
+ */
+template <typename T, typename Compare>
+std::vector<size_t> detectRuns(T* first, T* last, Compare comp) {
+    std::vector<size_t> bounds{0};
+    size_t n = last - first;
+    size_t start = 0;
+    while (start < n) {
+        size_t end = start + 1;
+        if (end < n && comp(first[end], first[end - 1])) {
+            while (end < n && comp(first[end], first[end - 1])) ++end;
+            std::reverse(first + start, first + end);
+        } else {
+            while (end < n && !comp(first[end], first[end - 1])) ++end;
+        }
+        bounds.push_back(end);
+        start = end;
+    }
+    return bounds;
+}
+
+/**
+ * @brief Stable bottom-up natural merge of consecutive sorted runs.
+ *
+ * @param bounds Run boundaries as returned by detectRuns(): 0, ..., total length.
+ */
+template <typename T, typename Compare>
+void mergeRuns(T* first, std::vector<size_t> bounds, Compare comp) {
+    // Each pass halves the number of runs.
+    while (bounds.size() > 2) {
+        std::vector<size_t> merged{0};
+        for (size_t i = 0; i + 2 < bounds.size(); i += 2) {
+            std::inplace_merge(first + bounds[i], first + bounds[i + 1], first + bounds[i + 2], comp);
+            merged.push_back(bounds[i + 2]);
+        }
+        if ((bounds.size() - 1) % 2 == 1) {
+            merged.push_back(bounds.back());
+        }
+        bounds.swap(merged);
+    }
+}
+
+/**
+ * @brief Sorts [first, last) by comp, exploiting runs that are already in order.
+ *
+ * - Tiny input (adaptiveSmallInput elements or fewer) is sorted directly without allocating.
+ * - Already sorted input is detected by one O(n) scan and left untouched.
+ * - Strictly reverse-sorted input is fixed by one O(n) reversal.
+ * - Input made of few long runs is finished by a stable natural merge, O(n log runs).
+ * - Anything else goes to the regular sort (the vectorized sort for int/float).
+ *
+ * @tparam Compare A strict weak ordering; std::less and std::greater select the vectorized fallback.
+ */
+template <typename T, typename Compare = std::less<T>>
+void adaptiveSort(T* first, T* last, Compare comp = Compare()) {
+    size_t n = last - first;
+    if (n < 2) {
+        return;
+    }
+    if (n <= adaptiveSmallInput) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<size_t> bounds = detectRuns(first, last, comp);
+    size_t runs = bounds.size() - 1;
+    if (runs == 1) {
+        return;
+    }
+
+    if (runs * adaptiveMinAverageRun <= n) {
+        mergeRuns(first, std::move(bounds), comp);
+        return;
+    }
+
+    if constexpr (std::is_same_v<Compare, std::less<T>>) {
+        simd::sort(first, last);
+    } else if constexpr (std::is_same_v<Compare, std::greater<T>>) {
+        simd::sortDescending(first, last);
+    } else {
+        std::sort(first, last, comp);
+    }
+}
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_ADAPTIVE_SORT_HPP
@@ -0,0 +1,152 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_ADAPTORS_HPP
+#define MYCONTAINERS_ADAPTORS_HPP
+
+#include "Container.hpp"
+#include "PersistentContainer.hpp"
+#include "StableContainer.hpp"
+#include "Order.hpp"
+#include "AscendingOrder.hpp"
+#include "DescendingOrder.hpp"
+#include "ReverseOrder.hpp"
+#include "SideCrossOrder.hpp"
+#include "MiddleOutOrder.hpp"
+#include "EytzingerOrder.hpp"
+#include "DistinctOrder.hpp"
+#include "FrequencyOrder.hpp"
+#include <cstddef>
+#include <memory>
+#include <ranges>
+#include <utility>
+
+namespace mycontainers {
+
+namespace detail {
+
+/**
+ * @brief An order view together with the container it reads, for containers that only exist for the view.
+ *
+ * Copies share the container, so they are as cheap as copies of View, and
+ * the container is released with the last copy. base() reaches View's own
+ * members (e.g. DistinctOrder::count()).
+ */
+template <typename View, typename T>
+class OwnedView : public std::ranges::view_interface<OwnedView<View, T>> {
+
+private:
+    std::shared_ptr<const Container<T>> owner; ///< Declared before view, which is built over it
+    View view;
+
+public:
+    template <typename... Args>
+    OwnedView(Container<T> c, Args&&... args)
+        : owner(std::make_shared<const Container<T>>(std::move(c))), view(*owner, std::forward<Args>(args)...) {}
+
+    /** @brief Returns the wrapped view. */
+    const View& base() const {
+        return view;
+    }
+
+    auto begin() const {
+        return view.begin();
+    }
+
+    auto end() const {
+        return view.end();
+    }
+};
+
+/**
+ * @brief Pipe adaptor that builds the order view View<T, N> from a Container<T, N>.
+ *
+ * The resulting view references the container, so piping a temporary container is rejected.
+ * A PersistentContainer version is viewed through a flat() Container owned by
+ * the view, and a StableContainer through its snapshot(), which leaves out the
+ * tombstones without compacting them.
+ */
+template <template <typename, size_t> class View>
+struct OrderAdaptor {
+    template <typename T, size_t N>
+    friend View<T, N> operator|(const Container<T, N>& c, OrderAdaptor) {
+        return View<T, N>(c);
+    }
+
+    template <typename T, size_t N>
+    friend View<T, N> operator|(const Container<T, N>&& c, OrderAdaptor) = delete;
+
+    template <typename T>
+    friend OwnedView<View<T, 0>, T> operator|(const PersistentContainer<T>& v, OrderAdaptor) {
+        return OwnedView<View<T, 0>, T>(v.flat());
+    }
+
+    template <typename T>
+    friend OwnedView<View<T, 0>, T> operator|(const StableContainer<T>& s, OrderAdaptor) {
+        return OwnedView<View<T, 0>, T>(s.snapshot());
+    }
+};
+
+/**
+ * @brief Pipe adaptor that builds a View<T, N> exposing only the first k elements of its order.
+ */
+template <template <typename, size_t> class View>
+struct TopKAdaptor {
+    size_t k;
+
+    template <typename T, size_t N>
+    friend View<T, N> operator|(const Container<T, N>& c, TopKAdaptor adaptor) {
+        return View<T, N>(c, adaptor.k);
+    }
+
+    template <typename T, size_t N>
+    friend View<T, N> operator|(const Container<T, N>&& c, TopKAdaptor adaptor) = delete;
+
+    template <typename T>
+    friend OwnedView<View<T, 0>, T> operator|(const PersistentContainer<T>& v, TopKAdaptor adaptor) {
+        return OwnedView<View<T, 0>, T>(v.flat(), adaptor.k);
+    }
+
+    template <typename T>
+    friend OwnedView<View<T, 0>, T> operator|(const StableContainer<T>& s, TopKAdaptor adaptor) {
+        return OwnedView<View<T, 0>, T>(s.snapshot(), adaptor.k);
+    }
+};
+
+/** @brief Factory for TopKAdaptor, so it can be written as smallest(k) / largest(k). */
+template <template <typename, size_t> class View>
+struct TopKFactory {
+    TopKAdaptor<View> operator()(size_t k) const {
+        return TopKAdaptor<View>{k};
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Pipeable adaptors: `c | mycontainers::ascending | std::views::take(10)`.
+ *
+ * Every order is a sized, random-access std::ranges::view, so it composes with
+ * the standard view adaptors without materializing intermediate containers.
+ */
+inline constexpr detail::OrderAdaptor<Order> in_order{};
+inline constexpr detail::OrderAdaptor<AscendingOrder> ascending{};
+inline constexpr detail::OrderAdaptor<DescendingOrder> descending{};
+inline constexpr detail::OrderAdaptor<ReverseOrder> reversed{};
+inline constexpr detail::OrderAdaptor<SideCrossOrder> side_cross{};
+inline constexpr detail::OrderAdaptor<MiddleOutOrder> middle_out{};
+inline constexpr detail::OrderAdaptor<EytzingerOrder> eytzinger{};
+inline constexpr detail::OrderAdaptor<DistinctOrder> distinct{};
+
+/**
+ * @brief Top-k adaptors: `c | mycontainers::smallest(10)` is the fused form of
+ *        `c | ascending | std::views::take(10)`, ordering only k elements (O(n log k)).
+ */
+inline constexpr detail::TopKFactory<AscendingOrder> smallest{};
+inline constexpr detail::TopKFactory<DescendingOrder> largest{};
+
+/** @brief `c | mycontainers::most_frequent(10)`: the 10 most common (value, count) pairs. */
+inline constexpr detail::TopKFactory<FrequencyOrder> most_frequent{};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_ADAPTORS_HPP
@@ -5,8 +5,13 @@
 
 #include "Container.hpp"
 #include "Iterator.hpp"
+#include "AdaptiveSort.hpp"
+#include "ViewStorage.hpp"
 #include <vector>
 #include <algorithm>
+#include <ranges>
+#include <type_traits>
+#include <variant>
 
 namespace mycontainers {
 
@@ -16,45 +21,135 @@ namespace mycontainers {
  * For example, if the container contains [7, 15, 6, 1, 2],
  * this iterator will yield: 1, 2, 6, 7, 15.
  *
+ * When the container is already sorted, or keeps a sorted index, the view
+ * shares that storage copy-on-write instead of sorting a copy (O(1) for a
+ * heap-backed container). Either way the view owns what it walks: it may
+ * outlive the container, and add() or remove() never change it; the first
+ * one while the view shares the storage clones it.
+ *
  * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container; a sorted copy, when one is needed, is kept inline too.
  */
-template <typename T = int>
-class AscendingOrder {
+template <typename T = int, size_t N = 0>
+class AscendingOrder : public std::ranges::view_interface<AscendingOrder<T, N>> {
 
 private:
-    std::vector<T> sortedData; ///< A sorted copy of the container's data
+    using storage_type = typename Container<T, N>::storage_type;
+
+    /** @brief Where the ascending sequence comes from. */
+    enum class Source { Copy, Data, Index };
+
+    detail::ViewStorage<storage_type, N == 0> sortedData; ///< A sorted copy of the container's data, unless shared holds sorted storage
+    std::conditional_t<N == 0, Container<T>, std::monostate> shared{}; ///< Copy-on-write share of a container whose data or index is already sorted
+    Source source = Source::Copy; ///< Which sequence of shared to walk, or the copy in sortedData
+    size_t length = 0; ///< Number of leading elements of the ascending sequence that the view exposes
+
+    /**
+     * @brief Takes the container's already sorted data or index as the sequence, without sorting.
+     *
+     * A heap-backed container is shared copy-on-write in O(1); an inline one is copied.
+     */
+    void adopt(const Container<T, N>& c, Source from) {
+        if constexpr (N == 0) {
+            shared = c;
+            source = from;
+        } else {
+            sortedData = detail::ViewStorage<storage_type, false>(from == Source::Data ? c.getData() : c.getSortedIndex());
+        }
+    }
+
+    /** @brief Returns the ascending sequence this view walks. */
+    const storage_type& view() const {
+        if constexpr (N == 0) {
+            if (source == Source::Data) return shared.getData();
+            if (source == Source::Index) return shared.getSortedIndex();
+        }
+        return sortedData.get();
+    }
 
 public:
-    using const_iterator = Iterator<typename std::vector<T>::const_iterator>;
+    using const_iterator = Iterator<typename Container<T, N>::storage_type::const_iterator>;
 
     /**
      * @brief Constructor that takes a reference to a container and copies its data sorted.
+     *
+     * Uses the container's own storage when it is sorted, its sorted index when
+     * present, and otherwise merges the run boundaries the container tracked on add().
      * 
      * @param c The container to traverse in ascending order.
      */
-    explicit AscendingOrder(const Container<T>& c) {
+    explicit AscendingOrder(const Container<T, N>& c) {
         const auto& data = c.getData();
 
         if (data.empty()) {
             return; // allow empty traversal (begin == end)
         }
-        
-        sortedData = data;
-        std::sort(sortedData.begin(), sortedData.end());
+        length = data.size();
+        if (c.isSorted()) {
+            adopt(c, Source::Data);
+            return;
+        }
+        if (c.hasSortedIndex()) {
+            adopt(c, Source::Index);
+            return;
+        }
+
+        storage_type sorted = data;
+        const auto& runs = c.getRunStarts();
+        if (c.allRunsTracked() && runs.size() * adaptiveMinAverageRun <= sorted.size()) {
+            std::vector<size_t> bounds(runs.begin(), runs.end());
+            bounds.push_back(sorted.size());
+            mergeRuns(sorted.data(), std::move(bounds), std::less<T>());
+        } else {
+            // Too many runs to merge: adaptiveSort still reverses descending input in O(n).
+            adaptiveSort(sorted.data(), sorted.data() + sorted.size());
+        }
+        sortedData = detail::ViewStorage<storage_type, N == 0>(std::move(sorted));
+    }
+
+    /**
+     * @brief Constructor that exposes only the k smallest elements, in ascending order.
+     *
+     * Sorted storage is shared as above; otherwise only the first k positions of
+     * the copy are ordered (partial sort), which costs O(n log k) instead of O(n log n).
+     *
+     * @param c The container to traverse in ascending order.
+     * @param k The maximal number of elements to expose.
+     */
+    AscendingOrder(const Container<T, N>& c, size_t k) {
+        const auto& data = c.getData();
+        length = std::min(k, data.size());
+
+        if (length == 0) {
+            return; // allow empty traversal (begin == end)
+        }
+        if (c.isSorted()) {
+            adopt(c, Source::Data);
+            return;
+        }
+        if (c.hasSortedIndex()) {
+            adopt(c, Source::Index);
+            return;
+        }
+
+        storage_type sorted = data;
+        std::partial_sort(sorted.begin(), sorted.begin() + length, sorted.end());
+        sorted.resize(length);
+        sortedData = detail::ViewStorage<storage_type, N == 0>(std::move(sorted));
     }
 
     /**
      * @brief Returns an iterator to the beginning of the sorted container.
      */
     const_iterator begin() const {
-        return const_iterator(sortedData.begin(), sortedData.end());
+        return const_iterator(view().begin(), view().begin() + length);
     }
 
     /**
      * @brief Returns an iterator to the end of the sorted container.
      */
     const_iterator end() const {
-        return const_iterator(sortedData.end(), sortedData.end());
+        return const_iterator(view().begin() + length, view().begin() + length);
     }
 };
 
@@ -0,0 +1,125 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_BLOOM_FILTER_HPP
+#define MYCONTAINERS_BLOOM_FILTER_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace mycontainers {
+
+/** @brief Satisfied by types that std::hash can hash, i.e. the types a BlockedBloomFilter accepts. */
+template <typename T>
+concept hashable = requires(const T& value) {
+    { std::hash<T>{}(value) } -> std::convertible_to<size_t>;
+};
+
+/**
+ * @brief A blocked (split-block) Bloom filter: approximate membership with no false negatives.
+ *
+ * Every value hashes to one 64-byte block, i.e. one cache line, and sets one bit
+ * in each of the block's eight 64-bit words. insert() and mayContain() therefore
+ * touch a single cache line and run without branches on the bits. With the
+ * default 10 bits per element the false positive rate stays around 1-2% up to
+ * the planned capacity. Elements cannot be deleted; the owner rebuilds the
+ * filter when it wants the stale bits gone.
+ *
+ * @tparam T The type of the values; hashed with std::hash<T>.
+ */
+template <typename T>
+class BlockedBloomFilter {
+
+private:
+    struct alignas(64) Block {
+        uint64_t words[8] = {};
+    };
+
+    std::vector<Block> blocks;
+    size_t plannedCapacity = 0;
+    size_t bitsPerValue = 10;
+
+    /** @brief std::hash is the identity for integers, so the bits are mixed first (splitmix64 finalizer). */
+    static uint64_t mix(uint64_t h) {
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return h;
+    }
+
+    /** @brief Sets or tests one bit per word: the bit index is the top 6 bits of a salted product. */
+    static uint64_t bitFor(uint32_t h, size_t word) {
+        static constexpr uint32_t salt[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                             0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+        return uint64_t(1) << ((h * salt[word]) >> 26);
+    }
+
+    /** @brief Maps the high 32 hash bits onto [0, blocks) without a division. */
+    size_t blockIndex(uint64_t h) const {
+        return ((h >> 32) * blocks.size()) >> 32;
+    }
+
+public:
+    /** @brief Creates an empty filter that rejects nothing until it is sized. */
+    BlockedBloomFilter() = default;
+
+    /**
+     * @brief Creates a filter sized for capacity values at bitsPerElement bits each.
+     *
+     * @throws std::invalid_argument if bitsPerElement is 0.
+     */
+    BlockedBloomFilter(size_t capacity, size_t bitsPerElement)
+        : plannedCapacity(capacity), bitsPerValue(bitsPerElement) {
+        if (bitsPerElement == 0) {
+            throw std::invalid_argument("Bloom filter needs at least one bit per element.");
+        }
+        blocks.resize(std::max<size_t>(1, (capacity * bitsPerElement + 511) / 512));
+    }
+
+    /** @brief Records value; mayContain(value) is true from now on. */
+    void insert(const T& value) {
+        if (blocks.empty()) {
+            return; // unsized: mayContain() answers true for everything anyway
+        }
+        uint64_t h = mix(std::hash<T>{}(value));
+        Block& block = blocks[blockIndex(h)];
+        for (size_t w = 0; w < 8; ++w) {
+            block.words[w] |= bitFor(static_cast<uint32_t>(h), w);
+        }
+    }
+
+    /** @brief Returns false only if value was never inserted; true means "possibly". */
+    bool mayContain(const T& value) const {
+        if (blocks.empty()) {
+            return true;
+        }
+        uint64_t h = mix(std::hash<T>{}(value));
+        const Block& block = blocks[blockIndex(h)];
+        uint64_t missing = 0;
+        for (size_t w = 0; w < 8; ++w) {
+            uint64_t bit = bitFor(static_cast<uint32_t>(h), w);
+            missing |= bit & ~block.words[w];
+        }
+        return missing == 0;
+    }
+
+    /** @brief Number of values the filter was sized for. */
+    size_t capacity() const {
+        return plannedCapacity;
+    }
+
+    /** @brief Bits of filter per planned value. */
+    size_t bitsPerElement() const {
+        return bitsPerValue;
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_BLOOM_FILTER_HPP
@@ -0,0 +1,94 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_CHUNKED_ITERATION_HPP
+#define MYCONTAINERS_CHUNKED_ITERATION_HPP
+
+#include "Iterator.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace mycontainers {
+
+namespace detail {
+
+/** @brief The raw iterator under one of our checked Iterator wrappers, or the iterator itself. */
+template <typename It>
+It rawIterator(const It& it) {
+    return it;
+}
+
+template <typename Iter>
+Iter rawIterator(const Iterator<Iter>& it) {
+    return it.base();
+}
+
+} // namespace detail
+
+/**
+ * @brief Hands the elements of a view to fn in blocks of up to chunkSize elements, in view order.
+ *
+ * fn receives a std::span<const T>; only the last block may be shorter. Views
+ * whose order is already laid out in memory (Order, AscendingOrder, SideCrossOrder,
+ * MiddleOutOrder, EytzingerOrder, DistinctOrder, FrequencyOrder, ...) are handed
+ * out as spans straight into that storage, with no copy and no per-element
+ * bounds check. Views that compute their order as they go (ReverseOrder,
+ * DescendingOrder, ShuffleOrder, StridedOrder, SampleOrder, std::views
+ * pipelines) are copied block by block into one staging buffer that is reused
+ * for every call, so the spans are only valid during the call.
+ *
+ * The view is taken by forwarding reference and walked as an lvalue, so
+ * views that can only be iterated non-const (std::views::filter, drop_while)
+ * work as well, as temporaries or not.
+ *
+ * @param view Any order view, or any other input range.
+ * @param chunkSize Maximal number of elements per block.
+ * @param fn Callable taking std::span<const T>.
+ * @throws std::invalid_argument if chunkSize is 0.
+ */
+template <typename View, typename Fn>
+    requires std::ranges::input_range<View>
+void for_each_chunk(View&& view, size_t chunkSize, Fn&& fn) {
+    using T = std::ranges::range_value_t<View>;
+    if (chunkSize == 0) {
+        throw std::invalid_argument("Chunk size must be positive.");
+    }
+    auto first = detail::rawIterator(std::ranges::begin(view));
+    auto last = detail::rawIterator(std::ranges::end(view));
+
+    if constexpr (std::contiguous_iterator<decltype(first)> && std::same_as<decltype(first), decltype(last)>) {
+        const T* data = std::to_address(first);
+        size_t size = static_cast<size_t>(last - first);
+        for (size_t offset = 0; offset < size; offset += chunkSize) {
+            fn(std::span<const T>(data + offset, std::min(chunkSize, size - offset)));
+        }
+    } else {
+        std::vector<T> staging;
+        if constexpr (std::ranges::sized_range<View>) {
+            staging.reserve(std::min(chunkSize, static_cast<size_t>(std::ranges::size(view))));
+        }
+        while (first != last) {
+            if constexpr (std::random_access_iterator<decltype(first)> && std::same_as<decltype(first), decltype(last)>) {
+                // Block copy: one length computation instead of a capacity check per element.
+                auto count = std::min<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(chunkSize), last - first);
+                staging.assign(first, first + count);
+                first += count;
+            } else {
+                staging.clear();
+                for (; first != last && staging.size() < chunkSize; ++first) {
+                    staging.push_back(*first);
+                }
+            }
+            fn(std::span<const T>(staging.data(), staging.size()));
+        }
+    }
+}
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_CHUNKED_ITERATION_HPP
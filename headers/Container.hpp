@@ -5,8 +5,16 @@
 
 #include <vector>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include "SimdKernels.hpp"
+#include "AdaptiveSort.hpp"
+#include "SmallVector.hpp"
+#include "BloomFilter.hpp"
 
 namespace mycontainers {
 
@@ -16,14 +24,200 @@ namespace mycontainers {
  * The container supports adding, removing, and accessing the size of its elements.
  * It also supports printing via the output stream operator.
  * 
+ * With an inline capacity N > 0 (e.g. Container<int, 16>), the elements, the
+ * sorted index and the run bookkeeping are kept in SmallVector buffers inside
+ * the object, so a container of at most N elements never allocates; it falls
+ * back to the heap transparently once it grows past N.
+ *
+ * Heap-backed containers (N == 0) are copy-on-write: a copy shares the
+ * elements, the sorted index and the run bookkeeping with its source, so
+ * taking a snapshot is O(1). The first add(), remove() or index change on
+ * either side clones the shared contents; the other side is never affected.
+ *
+ * An optional Bloom filter (buildFilter()) lets contains(), count(), remove()
+ * and maybe_contains() reject most absent values in O(1) without scanning.
+ * It needs std::hash<T>; without one every other operation still works.
+ *
  * @tparam T The type of elements stored in the container. Must support comparison and stream output.
+ * @tparam N Number of elements stored inline; 0 (the default) stores them in a std::vector.
  */
-template <typename T = int>
+template <typename T = int, size_t N = 0>
 
 class Container {
 
+public:
+    /// Element storage: std::vector<T>, or SmallVector<T, N> when an inline capacity is requested.
+    using storage_type = std::conditional_t<N == 0, std::vector<T>, SmallVector<T, N>>;
+
+    /// Storage for the run boundaries, inline under the same capacity as the elements.
+    using run_storage_type = std::conditional_t<N == 0, std::vector<size_t>, SmallVector<size_t, N>>;
+
+    /// Accumulator type used by sum(): 64-bit integers for integral T, double otherwise.
+    using sum_type = std::conditional_t<std::is_integral_v<T>,
+                                        std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>,
+                                        double>;
+
+    /// Run boundaries tracked at most; data with more runs is sorted from scratch anyway.
+    static constexpr size_t maxTrackedRuns = 64;
+
 private:
-    std::vector<T> data; ///< Internal dynamic array to store elements
+    /**
+     * @brief Everything derived from the element sequence; shared between copies until one of them mutates.
+     */
+    struct Contents {
+        storage_type data; ///< Internal dynamic array to store elements
+        storage_type sortedIndex; ///< Ascending copy of data, maintained only when hasIndex is set
+        bool hasIndex = false; ///< Whether sortedIndex is present and up to date
+        sum_type runningSum{}; ///< Running sum of all elements (arithmetic T only)
+        run_storage_type runStarts; ///< Start index of the first maxTrackedRuns maximal non-decreasing runs of data
+        bool runsOverflow = false; ///< Whether data has more runs than runStarts holds
+        BlockedBloomFilter<T> filter; ///< Approximate membership of data, maintained only when hasFilter is set
+        bool hasFilter = false; ///< Whether filter covers every element of data
+        size_t filterStale = 0; ///< Removed elements whose bits are still set in filter
+
+        /** @brief Records a run starting at index i, or the overflow once maxTrackedRuns are recorded. */
+        void startRun(size_t i) {
+            if (runStarts.size() < maxTrackedRuns) {
+                runStarts.push_back(i);
+            } else {
+                runsOverflow = true;
+            }
+        }
+
+        /** @brief Rebuilds runStarts with one scan, after a removal reshaped the data. */
+        void recomputeRuns() {
+            runStarts.clear();
+            runsOverflow = false;
+            for (size_t i = 0; i < data.size() && !runsOverflow; ++i) {
+                if (i == 0 || data[i] < data[i - 1]) {
+                    startRun(i);
+                }
+            }
+        }
+
+        /**
+         * @brief Re-adds every element into runningSum.
+         *
+         * Floating-point sums cannot be corrected by subtraction: an infinity
+         * turns into NaN and a large value absorbs the small ones added after it.
+         */
+        void recomputeSum() {
+            runningSum = sum_type{};
+            for (const T& value : data) {
+                runningSum += static_cast<sum_type>(value);
+            }
+        }
+
+        /** @brief Re-sizes the filter for twice the current size and re-inserts every element. */
+        void rebuildFilter(size_t bitsPerElement) {
+            filter = BlockedBloomFilter<T>(std::max<size_t>(64, 2 * data.size()), bitsPerElement);
+            for (const T& value : data) {
+                filter.insert(value);
+            }
+            filterStale = 0;
+        }
+
+        /** @brief Accounts for removed elements; rebuilds once stale bits outnumber live ones. */
+        void filterRemoved(size_t removed) {
+            if constexpr (hashable<T>) {
+                if (!hasFilter) {
+                    return;
+                }
+                filterStale += removed;
+                if (filterStale > data.size()) {
+                    rebuildFilter(filter.bitsPerElement());
+                }
+            }
+        }
+
+        /** @brief Returns true if the filter proves value absent. */
+        bool filterRejects(const T& value) const {
+            if constexpr (hashable<T>) {
+                return hasFilter && !filter.mayContain(value);
+            } else {
+                return false; // no filter without std::hash<T>
+            }
+        }
+    };
+
+    /// Heap-backed containers share their contents copy-on-write; inline ones (N > 0) hold them directly.
+    std::conditional_t<N == 0, std::shared_ptr<const Contents>, Contents> storage{};
+    std::optional<T> minValue; ///< Smallest element; engaged exactly when the container is non-empty
+    std::optional<T> maxValue; ///< Largest element; engaged exactly when the container is non-empty
+
+    /** @brief Read access to the contents; an empty container shares one static empty instance. */
+    const Contents& contents() const {
+        if constexpr (N == 0) {
+            static const Contents empty;
+            return storage ? *storage : empty;
+        } else {
+            return storage;
+        }
+    }
+
+    /**
+     * @brief Write access to the contents, cloning them first if another copy still shares them.
+     *
+     * This is the only place a copy pays for its elements, so copying stays O(1)
+     * and only the first add() or remove() afterwards costs O(n).
+     */
+    Contents& writableContents() {
+        if constexpr (N == 0) {
+            if (!storage || storage.use_count() > 1) {
+                storage = std::make_shared<Contents>(contents());
+            }
+            // Sole owner now: the pointee was created non-const by make_shared.
+            return const_cast<Contents&>(*storage);
+        } else {
+            return storage;
+        }
+    }
+
+    /** @brief Recomputes min and max with a linear scan after a removal may have taken one out. */
+    void repairExtrema() {
+        const Contents& s = contents();
+        if (s.data.empty()) {
+            minValue.reset();
+            maxValue.reset();
+            return;
+        }
+        if constexpr (simd::is_vectorizable_v<T>) {
+            auto [lo, hi] = simd::minMax(s.data.data(), s.data.size());
+            minValue = lo;
+            maxValue = hi;
+        } else {
+            // Generic path; also the only one for std::vector<bool>, which has no data().
+            auto [lo, hi] = std::minmax_element(s.data.begin(), s.data.end());
+            minValue = *lo;
+            maxValue = *hi;
+        }
+    }
+
+    /**
+     * @brief Places the elements at the given (sorted, unique) ranks into their final
+     *        sorted positions, partitioning the range once per rank.
+     */
+    static void multiSelect(T* first, T* last,
+                            const size_t* rankFirst, const size_t* rankLast, size_t offset) {
+        if (rankFirst == rankLast || first == last) {
+            return;
+        }
+        const size_t* pivotRank = rankFirst + (rankLast - rankFirst) / 2;
+        auto nth = first + (*pivotRank - offset);
+        std::nth_element(first, nth, last);
+        multiSelect(first, nth, rankFirst, pivotRank, offset);
+        multiSelect(nth + 1, last, pivotRank + 1, rankLast, *pivotRank + 1);
+    }
+
+    /**
+     * @brief Maps a quantile in [0, 1] to a 0-based rank (lower nearest rank).
+     */
+    size_t quantileRank(double q) const {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw std::invalid_argument("Quantile must be within [0, 1].");
+        }
+        return static_cast<size_t>(std::floor(q * static_cast<double>(contents().data.size() - 1)));
+    }
 
 public:
 
@@ -33,26 +227,23 @@ public:
     /**
      * @brief Copy constructor.
      * 
-     * Creates a new container by copying another container.
+     * Creates a new container by copying another container. For N == 0 the
+     * contents are shared, not copied, until one of the two containers mutates.
      * 
      * @param other The container to copy from.
      */
-    Container(const Container& other) : data(other.data) {}
+    Container(const Container& other) = default;
 
     /**
      * @brief Copy assignment operator.
      * 
-     * Assigns the contents of another container to this one.
+     * Assigns the contents of another container to this one, sharing them
+     * copy-on-write like the copy constructor.
      * 
      * @param other The container to assign from.
      * @return Container& Reference to this container.
      */
-    Container& operator=(const Container& other) {
-        if (this != &other) {
-            data = other.data;
-        }
-        return *this;
-    }
+    Container& operator=(const Container& other) = default;
 
     /**
      * @brief Destructor.
@@ -67,23 +258,126 @@ public:
      * @param value The element to add.
      */
     void add(const T& value) {
-        data.push_back(value);
+        Contents& s = writableContents();
+        if (s.data.empty() || value < s.data.back()) {
+            s.startRun(s.data.size());
+        }
+        s.data.push_back(value);
+        if (!minValue || value < *minValue) minValue = value;
+        if (!maxValue || *maxValue < value) maxValue = value;
+        if constexpr (std::is_arithmetic_v<T>) {
+            s.runningSum += static_cast<sum_type>(value);
+        }
+        if (s.hasIndex) {
+            s.sortedIndex.insert(std::upper_bound(s.sortedIndex.begin(), s.sortedIndex.end(), value), value);
+        }
+        if constexpr (hashable<T>) {
+            if (s.hasFilter) {
+                if (s.data.size() > s.filter.capacity()) {
+                    s.rebuildFilter(s.filter.bitsPerElement()); // amortized O(1): capacity doubles
+                } else {
+                    s.filter.insert(value);
+                }
+            }
+        }
     }
 
     /**
      * @brief Removes all occurrences of the given element from the container.
      * 
-     * If the element is not found, an exception is thrown.
+     * If the element is not found, an exception is thrown. With a filter, most
+     * absent values are rejected in O(1), before any scan or copy-on-write clone;
+     * a shared copy also checks for the value before cloning, so a failed
+     * remove() never pays for the clone.
      * 
      * @param value The element to remove.
      * @throws std::runtime_error if the element is not found.
      */
     void remove(const T& value) {
-        auto originalSize = data.size();
-        data.erase(std::remove(data.begin(), data.end(), value), data.end());
-        if (data.size() == originalSize) {
+        if (isShared() ? !contains(value) : contents().filterRejects(value)) {
             throw std::runtime_error("Element not found in container.");
         }
+        Contents& s = writableContents();
+        auto originalSize = s.data.size();
+        if constexpr (simd::is_vectorizable_v<T>) {
+            s.data.erase(s.data.begin() + simd::removeValue(s.data.data(), s.data.size(), value), s.data.end());
+        } else {
+            s.data.erase(std::remove(s.data.begin(), s.data.end(), value), s.data.end());
+        }
+        if (s.data.size() == originalSize) {
+            throw std::runtime_error("Element not found in container.");
+        }
+        if constexpr (std::is_floating_point_v<T>) {
+            s.recomputeSum(); // the removal already scanned every element
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            s.runningSum -= static_cast<sum_type>(value) * static_cast<sum_type>(originalSize - s.data.size());
+        }
+        s.recomputeRuns();
+        s.filterRemoved(originalSize - s.data.size());
+        if (!(*minValue < value) || !(value < *maxValue)) {
+            repairExtrema(); // the removal took out the min or max
+        }
+        if (s.hasIndex) {
+            auto range = std::equal_range(s.sortedIndex.begin(), s.sortedIndex.end(), value);
+            s.sortedIndex.erase(range.first, range.second);
+        }
+    }
+
+    /**
+     * @brief Removes the elements at the marked positions in one stable pass.
+     *
+     * Unlike remove(), this targets individual elements rather than every copy
+     * of a value, and it costs O(n) no matter how many positions are marked.
+     *
+     * @param marked One flag per element; true removes the element at that position.
+     * @return size_t The number of elements removed.
+     * @throws std::invalid_argument if marked.size() != size().
+     */
+    size_t removeMarked(const std::vector<bool>& marked) {
+        if (marked.size() != size()) {
+            throw std::invalid_argument("Mark bitmap size does not match the container size.");
+        }
+        if (std::find(marked.begin(), marked.end(), true) == marked.end()) {
+            return 0;
+        }
+        Contents& s = writableContents();
+        std::vector<T> removed;
+        size_t out = 0;
+        for (size_t i = 0; i < s.data.size(); ++i) {
+            if (marked[i]) {
+                removed.push_back(s.data[i]);
+            } else {
+                if (out != i) s.data[out] = std::move(s.data[i]);
+                ++out;
+            }
+        }
+        s.data.erase(s.data.begin() + out, s.data.end());
+        if constexpr (std::is_floating_point_v<T>) {
+            s.recomputeSum();
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            for (const T& value : removed) {
+                s.runningSum -= static_cast<sum_type>(value);
+            }
+        }
+        s.recomputeRuns();
+        s.filterRemoved(removed.size());
+        repairExtrema();
+        if (s.hasIndex) {
+            // Drop one index entry per removed element with a single merge-like pass.
+            std::sort(removed.begin(), removed.end());
+            size_t keep = 0;
+            size_t r = 0;
+            for (size_t i = 0; i < s.sortedIndex.size(); ++i) {
+                if (r < removed.size() && !(s.sortedIndex[i] < removed[r]) && !(removed[r] < s.sortedIndex[i])) {
+                    ++r;
+                } else {
+                    if (keep != i) s.sortedIndex[keep] = std::move(s.sortedIndex[i]);
+                    ++keep;
+                }
+            }
+            s.sortedIndex.erase(s.sortedIndex.begin() + keep, s.sortedIndex.end());
+        }
+        return removed.size();
     }
 
     /**
@@ -92,7 +386,19 @@ public:
      * @return size_t The number of elements.
      */
     size_t size() const {
-        return data.size();
+        return contents().data.size();
+    }
+
+    /**
+     * @brief Returns true if the contents are currently shared with another copy,
+     *        i.e. the next mutation will clone them. Always false for inline containers.
+     */
+    bool isShared() const {
+        if constexpr (N == 0) {
+            return storage.use_count() > 1;
+        } else {
+            return false;
+        }
     }
 
     /**
@@ -100,10 +406,308 @@ public:
      * 
      * This is useful for passing the data to iterators.
      * 
-     * @return const std::vector<T>&
+     * @return const storage_type&
+     */
+    const storage_type& getData() const {
+        return contents().data;
+    }
+
+    /**
+     * @brief Returns true if the elements are in non-decreasing order.
+     *
+     * Tracked on every add() in O(1), so ordered views can use the storage as-is.
+     */
+    bool isSorted() const {
+        return contents().runStarts.size() <= 1 && !contents().runsOverflow;
+    }
+
+    /**
+     * @brief Returns the start index of the maximal non-decreasing runs, in order.
+     *
+     * Empty for an empty container; {0} when the container is sorted. At most
+     * maxTrackedRuns starts are kept, so the bookkeeping stays O(1) in memory;
+     * see allRunsTracked().
+     */
+    const run_storage_type& getRunStarts() const {
+        return contents().runStarts;
+    }
+
+    /**
+     * @brief Returns true if getRunStarts() lists every run, false if the data has more than maxTrackedRuns.
+     */
+    bool allRunsTracked() const {
+        return !contents().runsOverflow;
+    }
+
+    /**
+     * @brief Returns the smallest element.
+     *
+     * O(1): add() keeps it up to date, and a removal that takes out the
+     * minimum rescans the remaining elements right away. Being a pure read,
+     * it is safe to call concurrently with other const queries.
+     *
+     * @throws std::out_of_range if the container is empty.
+     */
+    const T& min() const {
+        if (!minValue) {
+            throw std::out_of_range("Minimum of empty container.");
+        }
+        return *minValue;
+    }
+
+    /**
+     * @brief Returns the largest element.
+     *
+     * O(1): add() keeps it up to date, and a removal that takes out the
+     * maximum rescans the remaining elements right away. Being a pure read,
+     * it is safe to call concurrently with other const queries.
+     *
+     * @throws std::out_of_range if the container is empty.
+     */
+    const T& max() const {
+        if (!maxValue) {
+            throw std::out_of_range("Maximum of empty container.");
+        }
+        return *maxValue;
+    }
+
+    /**
+     * @brief Returns the sum of all elements in O(1). Only available for arithmetic T.
+     *
+     * For floating-point T a removal re-adds the remaining elements (it scans
+     * them anyway), so the sum never carries the rounding of removed values.
+     *
+     * @return sum_type The running sum (0 for an empty container).
+     */
+    sum_type sum() const {
+        static_assert(std::is_arithmetic_v<T>, "sum() requires an arithmetic element type.");
+        return contents().runningSum;
+    }
+
+    /**
+     * @brief Returns the number of elements equal to the given value.
+     *
+     * O(log n) with a sorted index, otherwise a linear scan; O(1) for most absent
+     * values when a filter is present.
+     */
+    size_t count(const T& value) const {
+        const Contents& s = contents();
+        if (s.filterRejects(value)) {
+            return 0;
+        }
+        if (s.hasIndex) {
+            auto range = std::equal_range(s.sortedIndex.begin(), s.sortedIndex.end(), value);
+            return range.second - range.first;
+        }
+        if constexpr (simd::is_vectorizable_v<T>) {
+            return simd::count(s.data.data(), s.data.size(), value);
+        } else {
+            return static_cast<size_t>(std::count(s.data.begin(), s.data.end(), value));
+        }
+    }
+
+    /**
+     * @brief Returns true if at least one element equals the given value.
+     *
+     * O(log n) with a sorted index, otherwise a linear scan that stops at the first
+     * match. A filter answers most absent values in O(1) before either.
+     */
+    bool contains(const T& value) const {
+        const Contents& s = contents();
+        if (s.filterRejects(value)) {
+            return false;
+        }
+        if (s.hasIndex) {
+            return std::binary_search(s.sortedIndex.begin(), s.sortedIndex.end(), value);
+        }
+        if constexpr (simd::is_vectorizable_v<T>) {
+            return simd::contains(s.data.data(), s.data.size(), value);
+        } else {
+            return std::find(s.data.begin(), s.data.end(), value) != s.data.end();
+        }
+    }
+
+    /**
+     * @brief Returns false if value is certainly absent; true if it may be present.
+     *
+     * O(1) with a filter (see buildFilter()), which admits a small rate of false
+     * positives. Without a filter the answer is exact and costs a contains().
+     */
+    bool maybe_contains(const T& value) const {
+        if constexpr (hashable<T>) {
+            const Contents& s = contents();
+            if (s.hasFilter) {
+                return s.filter.mayContain(value);
+            }
+        }
+        return contains(value);
+    }
+
+    /**
+     * @brief Builds a blocked Bloom filter over the elements and keeps it up to date afterwards.
+     *
+     * add() inserts into the filter in O(1); removals leave stale bits behind,
+     * and the filter is rebuilt once they outnumber the live elements.
+     *
+     * Only available when std::hash<T> is; the rest of the container does not need it.
+     *
+     * @param bitsPerElement Filter bits per element; 10 gives about 1% false positives.
+     * @throws std::invalid_argument if bitsPerElement is 0.
+     */
+    void buildFilter(size_t bitsPerElement = 10) {
+        static_assert(hashable<T>, "buildFilter() requires std::hash<T>.");
+        if (bitsPerElement == 0) {
+            throw std::invalid_argument("Bloom filter needs at least one bit per element.");
+        }
+        Contents& s = writableContents();
+        s.rebuildFilter(bitsPerElement);
+        s.hasFilter = true;
+    }
+
+    /** @brief Discards the filter; membership queries scan again. */
+    void dropFilter() {
+        if (!contents().hasFilter) {
+            return;
+        }
+        Contents& s = writableContents();
+        s.filter = BlockedBloomFilter<T>();
+        s.hasFilter = false;
+        s.filterStale = 0;
+    }
+
+    /** @brief Returns true if a membership filter is currently maintained. */
+    bool hasFilter() const {
+        return contents().hasFilter;
+    }
+
+    /**
+     * @brief Builds a sorted index over the elements and keeps it up to date afterwards.
+     *
+     * While the index is present, select() is O(1) and rank() is O(log n);
+     * add() and remove() pay an extra ordered insert/erase to maintain it.
      */
-    const std::vector<T>& getData() const {
-        return data;
+    void buildSortedIndex() {
+        Contents& s = writableContents();
+        s.sortedIndex = s.data;
+        adaptiveSort(s.sortedIndex.data(), s.sortedIndex.data() + s.sortedIndex.size());
+        s.hasIndex = true;
+    }
+
+    /** @brief Discards the sorted index, returning to plain append-only maintenance. */
+    void dropSortedIndex() {
+        if (!contents().hasIndex) {
+            return;
+        }
+        Contents& s = writableContents();
+        s.sortedIndex.clear();
+        s.sortedIndex.shrink_to_fit();
+        s.hasIndex = false;
+    }
+
+    /** @brief Returns true if a sorted index is currently maintained. */
+    bool hasSortedIndex() const {
+        return contents().hasIndex;
+    }
+
+    /**
+     * @brief Returns the sorted index.
+     *
+     * @throws std::logic_error if no sorted index has been built.
+     */
+    const storage_type& getSortedIndex() const {
+        const Contents& s = contents();
+        if (!s.hasIndex) {
+            throw std::logic_error("Container has no sorted index.");
+        }
+        return s.sortedIndex;
+    }
+
+    /**
+     * @brief Returns the k-th smallest element (0-based).
+     *
+     * O(1) with a sorted index, otherwise an O(n) nth_element pass over a copy.
+     *
+     * @param k The rank to select.
+     * @throws std::out_of_range if k >= size().
+     */
+    T select(size_t k) const {
+        const Contents& s = contents();
+        if (k >= s.data.size()) {
+            throw std::out_of_range("Rank out of range.");
+        }
+        if (s.hasIndex) {
+            return s.sortedIndex[k];
+        }
+        storage_type scratch = s.data;
+        std::nth_element(scratch.begin(), scratch.begin() + k, scratch.end());
+        return scratch[k];
+    }
+
+    /**
+     * @brief Returns the number of elements strictly smaller than the given value.
+     *
+     * O(log n) with a sorted index, otherwise a linear scan.
+     */
+    size_t rank(const T& value) const {
+        const Contents& s = contents();
+        if (s.hasIndex) {
+            return std::lower_bound(s.sortedIndex.begin(), s.sortedIndex.end(), value) - s.sortedIndex.begin();
+        }
+        return std::count_if(s.data.begin(), s.data.end(), [&value](const T& x) { return x < value; });
+    }
+
+    /**
+     * @brief Returns the element at quantile q, using the lower nearest rank floor(q * (n - 1)).
+     *
+     * @throws std::out_of_range if the container is empty.
+     * @throws std::invalid_argument if q is outside [0, 1].
+     */
+    T quantile(double q) const {
+        if (contents().data.empty()) {
+            throw std::out_of_range("Quantile of empty container.");
+        }
+        return select(quantileRank(q));
+    }
+
+    /**
+     * @brief Answers several quantiles at once, in the order they were requested.
+     *
+     * Without a sorted index, a single copy of the data is partitioned by one
+     * multi-select pass, so m quantiles cost O(n log m) instead of m separate selections.
+     *
+     * @throws std::out_of_range if the container is empty.
+     * @throws std::invalid_argument if any quantile is outside [0, 1].
+     */
+    std::vector<T> quantiles(const std::vector<double>& qs) const {
+        const Contents& s = contents();
+        if (s.data.empty()) {
+            throw std::out_of_range("Quantile of empty container.");
+        }
+        std::vector<size_t> ranks;
+        ranks.reserve(qs.size());
+        for (double q : qs) {
+            ranks.push_back(quantileRank(q));
+        }
+
+        std::vector<T> result;
+        result.reserve(ranks.size());
+        if (s.hasIndex) {
+            for (size_t r : ranks) {
+                result.push_back(s.sortedIndex[r]);
+            }
+            return result;
+        }
+
+        std::vector<size_t> unique = ranks;
+        std::sort(unique.begin(), unique.end());
+        unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+        storage_type scratch = s.data;
+        multiSelect(scratch.data(), scratch.data() + scratch.size(), unique.data(), unique.data() + unique.size(), 0);
+        for (size_t r : ranks) {
+            result.push_back(scratch[r]);
+        }
+        return result;
     }
 
     /**
@@ -113,11 +717,12 @@ public:
      * @param c The container to print.
      * @return std::ostream& Reference to the output stream.
      */
-    friend std::ostream& operator<<(std::ostream& os, const Container<T>& c) {
+    friend std::ostream& operator<<(std::ostream& os, const Container& c) {
+        const storage_type& data = c.getData();
         os << "[";
-        for (size_t i = 0; i < c.data.size(); ++i) {
-            os << c.data[i];
-            if (i < c.data.size() - 1) os << ", ";
+        for (size_t i = 0; i < data.size(); ++i) {
+            os << data[i];
+            if (i < data.size() - 1) os << ", ";
         }
         os << "]";
         return os;
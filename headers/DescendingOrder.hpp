@@ -5,8 +5,14 @@
 
 #include "Container.hpp"
 #include "Iterator.hpp"
+#include "AdaptiveSort.hpp"
+#include "ViewStorage.hpp"
 #include <vector>
 #include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <variant>
 
 namespace mycontainers {
 
@@ -15,46 +21,126 @@ namespace mycontainers {
  * 
  * For example, if the container contains [7, 15, 6, 1, 2],
  * this iterator will yield: 15, 7, 6, 2, 1.
+ *
+ * The view walks an ascending sequence backwards. When the container is already
+ * sorted, or keeps a sorted index, that sequence is the container's own storage,
+ * shared copy-on-write rather than sorted again. Either way the view owns what
+ * it walks, so it may outlive the container and is not changed by add() or remove().
  * 
  * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container, also used for the view's own sorted copy.
  */
-template <typename T = int>
-class DescendingOrder {
+template <typename T = int, size_t N = 0>
+class DescendingOrder : public std::ranges::view_interface<DescendingOrder<T, N>> {
 
 private:
-    std::vector<T> sortedData; ///< A sorted copy of the container's data, in descending order.
+    using storage_type = typename Container<T, N>::storage_type;
+
+    /** @brief Where the ascending sequence comes from. */
+    enum class Source { Copy, Data, Index };
+
+    detail::ViewStorage<storage_type, N == 0> sortedData; ///< An ascending copy of the container's data, unless shared holds sorted storage
+    std::conditional_t<N == 0, Container<T>, std::monostate> shared{}; ///< Copy-on-write share of a container whose data or index is already sorted
+    Source source = Source::Copy; ///< Which sequence of shared to walk, or the copy in sortedData
+    size_t length = 0; ///< Number of trailing elements of the ascending sequence that the view exposes
+
+    /**
+     * @brief Takes the container's already sorted data or index as the sequence, without sorting.
+     *
+     * A heap-backed container is shared copy-on-write in O(1); an inline one is copied.
+     */
+    void adopt(const Container<T, N>& c, Source from) {
+        if constexpr (N == 0) {
+            shared = c;
+            source = from;
+        } else {
+            sortedData = detail::ViewStorage<storage_type, false>(from == Source::Data ? c.getData() : c.getSortedIndex());
+        }
+    }
+
+    /** @brief Returns the ascending sequence this view walks backwards. */
+    const storage_type& view() const {
+        if constexpr (N == 0) {
+            if (source == Source::Data) return shared.getData();
+            if (source == Source::Index) return shared.getSortedIndex();
+        }
+        return sortedData.get();
+    }
 
 public:
-    using const_iterator = Iterator<typename std::vector<T>::const_iterator>;
+    using const_iterator = Iterator<std::reverse_iterator<typename Container<T, N>::storage_type::const_iterator>>;
 
     /**
-     * @brief Constructor that takes a reference to a container and copies its data sorted in descending order.
+     * @brief Constructor that takes a reference to a container and prepares its data in sorted order.
      * 
      * @param c The container to traverse in descending order.
      */
-    explicit DescendingOrder(const Container<T>& c) {
+    explicit DescendingOrder(const Container<T, N>& c) {
         const auto& data = c.getData();
         
         if (data.empty()) {
             return; // allow empty traversal (begin == end)
         }
-        
-        sortedData = data;
-        std::sort(sortedData.begin(), sortedData.end(), std::greater<T>());
+        length = data.size();
+        if (c.isSorted()) {
+            adopt(c, Source::Data);
+            return;
+        }
+        if (c.hasSortedIndex()) {
+            adopt(c, Source::Index);
+            return;
+        }
+
+        storage_type sorted = data;
+        adaptiveSort(sorted.data(), sorted.data() + sorted.size());
+        sortedData = detail::ViewStorage<storage_type, N == 0>(std::move(sorted));
+    }
+
+    /**
+     * @brief Constructor that exposes only the k largest elements, in descending order.
+     *
+     * Sorted storage is shared as above; otherwise the k largest elements are
+     * selected to the back of the copy and only those are sorted, O(n + k log k).
+     *
+     * @param c The container to traverse in descending order.
+     * @param k The maximal number of elements to expose.
+     */
+    DescendingOrder(const Container<T, N>& c, size_t k) {
+        const auto& data = c.getData();
+        length = std::min(k, data.size());
+
+        if (length == 0) {
+            return; // allow empty traversal (begin == end)
+        }
+        if (c.isSorted()) {
+            adopt(c, Source::Data);
+            return;
+        }
+        if (c.hasSortedIndex()) {
+            adopt(c, Source::Index);
+            return;
+        }
+
+        storage_type sorted = data;
+        auto firstKept = sorted.end() - length;
+        std::nth_element(sorted.begin(), firstKept, sorted.end());
+        std::sort(firstKept, sorted.end());
+        sorted.erase(sorted.begin(), firstKept);
+        sortedData = detail::ViewStorage<storage_type, N == 0>(std::move(sorted));
     }
 
     /**
      * @brief Returns an iterator to the beginning of the sorted (descending) container.
      */
     const_iterator begin() const {
-        return const_iterator(sortedData.begin(), sortedData.end());
+        return const_iterator(view().rbegin(), view().rbegin() + length);
     }
 
     /**
      * @brief Returns an iterator to the end of the sorted (descending) container.
      */
     const_iterator end() const {
-        return const_iterator(sortedData.end(), sortedData.end());
+        return const_iterator(view().rbegin() + length, view().rbegin() + length);
     }
 };
 
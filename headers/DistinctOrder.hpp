@@ -0,0 +1,168 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_DISTINCT_ORDER_HPP
+#define MYCONTAINERS_DISTINCT_ORDER_HPP
+
+#include "Container.hpp"
+#include "Iterator.hpp"
+#include "AdaptiveSort.hpp"
+#include "ViewStorage.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace mycontainers {
+
+/** @brief Tag selecting the hash-based DistinctOrder, which keeps first-occurrence order. */
+struct FirstSeenTag {};
+inline constexpr FirstSeenTag first_seen{};
+
+/**
+ * @brief An iterator that yields every distinct value of the container once, smallest first.
+ *
+ * For example, if the container contains [7, 1, 15, 7, 1, 2],
+ * this iterator will yield: 1, 2, 7, 15 (with counts 2, 1, 2, 1).
+ *
+ * Only the distinct values and their multiplicities are stored. A sorted
+ * container, or its sorted index, is run-length scanned in O(n) without a copy;
+ * otherwise a copy is sorted first. With the first_seen tag, a hash table groups
+ * the values in one O(n) pass instead and they come out in order of first occurrence.
+ *
+ * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container (see Container).
+ */
+template <typename T = int, size_t N = 0>
+class DistinctOrder : public std::ranges::view_interface<DistinctOrder<T, N>> {
+
+private:
+    struct Table {
+        std::vector<T> values;      ///< Distinct values, ascending (or in first-seen order)
+        std::vector<size_t> counts; ///< Multiplicity of values[i]
+    };
+    detail::ViewStorage<Table> table; ///< Shared by copies of the view
+    bool ascendingOrder = true; ///< False for the first_seen variant
+
+    /** @brief Collapses equal neighbours of a sorted range into values/counts. */
+    static Table collapse(const T* first, const T* last) {
+        Table t;
+        for (const T* it = first; it != last; ++it) {
+            if (t.values.empty() || t.values.back() < *it) {
+                t.values.push_back(*it);
+                t.counts.push_back(1);
+            } else {
+                ++t.counts.back();
+            }
+        }
+        return t;
+    }
+
+    /** @brief Returns the position of value in values, or values.size() if absent. */
+    size_t find(const T& value) const {
+        const auto& values = table.get().values;
+        if (ascendingOrder) {
+            auto it = std::lower_bound(values.begin(), values.end(), value);
+            return it != values.end() && !(value < *it) ? it - values.begin() : values.size();
+        }
+        return std::find(values.begin(), values.end(), value) - values.begin();
+    }
+
+public:
+    using const_iterator = Iterator<typename std::vector<T>::const_iterator>;
+
+    /**
+     * @brief Constructor that takes a reference to a container and collects its distinct values, ascending.
+     *
+     * @param c The container to deduplicate.
+     */
+    explicit DistinctOrder(const Container<T, N>& c) {
+        const auto& data = c.getData();
+        if (c.isSorted()) {
+            table = detail::ViewStorage<Table>(collapse(data.data(), data.data() + data.size()));
+        } else if (c.hasSortedIndex()) {
+            const auto& index = c.getSortedIndex();
+            table = detail::ViewStorage<Table>(collapse(index.data(), index.data() + index.size()));
+        } else {
+            std::vector<T> sorted(data.begin(), data.end());
+            adaptiveSort(sorted.data(), sorted.data() + sorted.size());
+            table = detail::ViewStorage<Table>(collapse(sorted.data(), sorted.data() + sorted.size()));
+        }
+    }
+
+    /**
+     * @brief Constructor that collects the distinct values with a hash table, in order of first occurrence.
+     *
+     * O(n) expected and needs std::hash<T>; the output is not sorted.
+     *
+     * @param c The container to deduplicate.
+     */
+    DistinctOrder(const Container<T, N>& c, FirstSeenTag) : ascendingOrder(false) {
+        Table t;
+        std::unordered_map<T, size_t> position;
+        for (const T& value : c.getData()) {
+            auto [it, inserted] = position.try_emplace(value, t.values.size());
+            if (inserted) {
+                t.values.push_back(value);
+                t.counts.push_back(1);
+            } else {
+                ++t.counts[it->second];
+            }
+        }
+        table = detail::ViewStorage<Table>(std::move(t));
+    }
+
+    /** @brief Returns the number of distinct values. */
+    size_t size() const {
+        return table.get().values.size();
+    }
+
+    /**
+     * @brief Returns how many times the i-th distinct value of the view occurs.
+     *
+     * @throws std::out_of_range if i >= size().
+     */
+    size_t countAt(size_t i) const {
+        const auto& counts = table.get().counts;
+        if (i >= counts.size()) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return counts[i];
+    }
+
+    /**
+     * @brief Returns how many times value occurs in the container (0 if it does not).
+     *
+     * O(log d) for the ascending view, O(d) for first_seen, d being the number of distinct values.
+     */
+    size_t count(const T& value) const {
+        size_t i = find(value);
+        return i < size() ? table.get().counts[i] : 0;
+    }
+
+    /** @brief Returns the multiplicities, parallel to the iteration order. */
+    const std::vector<size_t>& getCounts() const {
+        return table.get().counts;
+    }
+
+    /**
+     * @brief Returns an iterator to the first distinct value.
+     */
+    const_iterator begin() const {
+        const auto& values = table.get().values;
+        return const_iterator(values.begin(), values.end());
+    }
+
+    /**
+     * @brief Returns an iterator past the last distinct value.
+     */
+    const_iterator end() const {
+        const auto& values = table.get().values;
+        return const_iterator(values.end(), values.end());
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_DISTINCT_ORDER_HPP
@@ -0,0 +1,339 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_EXTERNAL_SORT_HPP
+#define MYCONTAINERS_EXTERNAL_SORT_HPP
+
+#include "Container.hpp"
+#include "Order.hpp"
+#include "Generator.hpp"
+#include "AdaptiveSort.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * @brief Tuning knobs for ExternalAscendingOrder.
+ */
+struct ExternalSortConfig {
+    std::filesystem::path directory; ///< Where sorted runs are spilled; empty means the system temp directory, looked up at the first spill
+    size_t memoryBudget = size_t(64) << 20; ///< Bytes of elements sorted in memory per run, and bytes of merge buffers
+    size_t blockSize = size_t(1) << 16;     ///< Bytes read or written per I/O call while merging
+};
+
+namespace detail {
+
+/**
+ * @brief A temporary file holding one sorted run; the file is deleted with the object.
+ */
+class SpillFile {
+private:
+    std::filesystem::path path;
+
+public:
+    explicit SpillFile(const std::filesystem::path& directory) {
+        static std::atomic<unsigned long long> counter{0};
+        std::random_device entropy;
+        path = directory / ("mycontainers-run-" + std::to_string(entropy()) + "-" +
+                            std::to_string(counter.fetch_add(1)) + ".bin");
+    }
+
+    SpillFile(SpillFile&& other) noexcept : path(std::exchange(other.path, {})) {}
+
+    SpillFile& operator=(SpillFile&& other) noexcept {
+        if (this != &other) {
+            discard();
+            path = std::exchange(other.path, {});
+        }
+        return *this;
+    }
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    ~SpillFile() { discard(); }
+
+    const std::filesystem::path& getPath() const { return path; }
+
+private:
+    void discard() noexcept {
+        if (!path.empty()) {
+            std::error_code ignored;
+            std::filesystem::remove(path, ignored);
+        }
+    }
+};
+
+/**
+ * @brief Buffered sequential reader over a run file, refilled one block at a time.
+ */
+template <typename T>
+class RunReader {
+private:
+    std::ifstream in;
+    std::vector<T> buffer;
+    std::filesystem::path path;
+    size_t pos = 0;
+    size_t filled = 0;
+
+public:
+    RunReader(const std::filesystem::path& p, size_t blockElements)
+        : in(p, std::ios::binary), buffer(blockElements), path(p) {
+        if (!in) {
+            throw std::runtime_error("Cannot open spill file: " + path.string());
+        }
+        refill();
+    }
+
+    bool exhausted() const { return pos == filled; }
+
+    const T& head() const { return buffer[pos]; }
+
+    void advance() {
+        if (++pos == filled) {
+            refill();
+        }
+    }
+
+private:
+    /** @throws std::runtime_error on an I/O error or a partial element, rather than ending the run early. */
+    void refill() {
+        in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(T)));
+        size_t bytes = static_cast<size_t>(in.gcount());
+        if (in.bad() || bytes % sizeof(T) != 0) {
+            throw std::runtime_error("Cannot read spill file: " + path.string());
+        }
+        filled = bytes / sizeof(T);
+        pos = 0;
+    }
+};
+
+/**
+ * @brief Buffered sequential writer of a run file, flushed one block at a time.
+ */
+template <typename T>
+class RunWriter {
+private:
+    std::ofstream out;
+    std::vector<T> buffer;
+    std::filesystem::path path;
+
+public:
+    RunWriter(const std::filesystem::path& p, size_t blockElements)
+        : out(p, std::ios::binary | std::ios::trunc), path(p) {
+        if (!out) {
+            throw std::runtime_error("Cannot create spill file: " + p.string());
+        }
+        buffer.reserve(blockElements);
+    }
+
+    void push(const T& value) {
+        buffer.push_back(value);
+        if (buffer.size() == buffer.capacity()) {
+            flush();
+        }
+    }
+
+    void write(const T* data, size_t n) {
+        flush();
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(n * sizeof(T)));
+        check();
+    }
+
+    void flush() {
+        if (!buffer.empty()) {
+            out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(T)));
+            buffer.clear();
+            check();
+        }
+    }
+
+private:
+    void check() {
+        if (!out) {
+            throw std::runtime_error("Cannot write spill file: " + path.string());
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Ascending traversal of data that may not fit in memory (external merge sort).
+ *
+ * The source is consumed in runs of at most memoryBudget bytes; each run is
+ * sorted in memory and spilled to a temporary file in the configured directory.
+ * If there are more runs than merge buffers fit in the budget, runs are merged
+ * in extra passes until they do. Iteration then performs a buffered k-way merge,
+ * reading blockSize bytes per run at a time. If the whole source fits in one run,
+ * nothing is written to disk. Spill files are deleted with the object.
+ *
+ * Elements are spilled as raw bytes, so T must be trivially copyable.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T = int>
+class ExternalAscendingOrder {
+    static_assert(std::is_trivially_copyable_v<T>, "ExternalAscendingOrder spills raw bytes and needs a trivially copyable T.");
+
+private:
+    ExternalSortConfig config;
+    std::vector<T> inMemory;              ///< The only run, when the source fitted in the memory budget
+    std::vector<detail::SpillFile> runs;  ///< Sorted runs on disk, at most fanIn() of them
+    size_t count = 0;                     ///< Total number of elements
+    Generator<T> stream;                  ///< The merge currently being iterated
+
+    size_t runElements() const { return std::max<size_t>(1, config.memoryBudget / sizeof(T)); }
+    size_t blockElements() const { return std::max<size_t>(1, config.blockSize / sizeof(T)); }
+    size_t fanIn() const { return std::max<size_t>(2, config.memoryBudget / std::max<size_t>(1, config.blockSize)); }
+
+    /** @brief The spill directory; the temp directory is only looked up once something is spilled. */
+    const std::filesystem::path& spillDirectory() {
+        if (config.directory.empty()) {
+            config.directory = std::filesystem::temp_directory_path();
+        }
+        return config.directory;
+    }
+
+    void spill(std::vector<T>& buffer) {
+        adaptiveSort(buffer.data(), buffer.data() + buffer.size());
+        detail::SpillFile file(spillDirectory());
+        detail::RunWriter<T> writer(file.getPath(), blockElements());
+        writer.write(buffer.data(), buffer.size());
+        writer.flush();
+        runs.push_back(std::move(file));
+        buffer.clear();
+    }
+
+    /** @brief Yields the elements of the given runs in ascending order. */
+    static Generator<T> mergeFiles(std::vector<const detail::SpillFile*> group, size_t blockElements) {
+        std::vector<detail::RunReader<T>> readers;
+        readers.reserve(group.size());
+        for (const auto* file : group) {
+            readers.emplace_back(file->getPath(), blockElements);
+        }
+        auto greaterHead = [&readers](size_t a, size_t b) { return readers[b].head() < readers[a].head(); };
+        std::priority_queue<size_t, std::vector<size_t>, decltype(greaterHead)> heads(greaterHead);
+        for (size_t i = 0; i < readers.size(); ++i) {
+            if (!readers[i].exhausted()) heads.push(i);
+        }
+        while (!heads.empty()) {
+            size_t top = heads.top();
+            heads.pop();
+            co_yield readers[top].head();
+            readers[top].advance();
+            if (!readers[top].exhausted()) heads.push(top);
+        }
+    }
+
+    /** @brief Merges groups of runs into longer runs until one k-way merge can cover them all. */
+    void reduceRuns() {
+        while (runs.size() > fanIn()) {
+            std::vector<detail::SpillFile> merged;
+            for (size_t start = 0; start < runs.size(); start += fanIn()) {
+                size_t stop = std::min(runs.size(), start + fanIn());
+                std::vector<const detail::SpillFile*> group;
+                for (size_t i = start; i < stop; ++i) group.push_back(&runs[i]);
+
+                detail::SpillFile file(spillDirectory());
+                detail::RunWriter<T> writer(file.getPath(), blockElements());
+                for (const T& value : mergeFiles(group, blockElements())) {
+                    writer.push(value);
+                }
+                writer.flush();
+                merged.push_back(std::move(file));
+            }
+            runs = std::move(merged);
+        }
+    }
+
+    Generator<T> mergeAll() const {
+        if (runs.empty()) {
+            for (const T& value : inMemory) co_yield value;
+            co_return;
+        }
+        std::vector<const detail::SpillFile*> group;
+        for (const auto& file : runs) group.push_back(&file);
+        for (const T& value : mergeFiles(group, blockElements())) co_yield value;
+    }
+
+public:
+    /**
+     * @brief Sorts any input range (a container view, a Generator, ...) externally.
+     *
+     * @throws std::invalid_argument if the budget or block size is smaller than one element.
+     * @throws std::runtime_error if a spill file cannot be created, written or read back,
+     *         or if the temp directory is needed and cannot be found (std::filesystem::filesystem_error).
+     */
+    template <std::ranges::input_range R>
+        requires (!std::is_same_v<std::remove_cvref_t<R>, ExternalAscendingOrder>)
+    explicit ExternalAscendingOrder(R&& source, ExternalSortConfig cfg = {}) : config(std::move(cfg)) {
+        if (config.memoryBudget < sizeof(T) || config.blockSize < sizeof(T)) {
+            throw std::invalid_argument("Memory budget and block size must hold at least one element.");
+        }
+        std::vector<T> buffer;
+        buffer.reserve(std::min<size_t>(runElements(), size_t(1) << 20));
+        for (auto&& value : source) {
+            buffer.push_back(value);
+            ++count;
+            if (buffer.size() == runElements()) {
+                spill(buffer);
+            }
+        }
+        if (runs.empty()) {
+            adaptiveSort(buffer.data(), buffer.data() + buffer.size());
+            inMemory = std::move(buffer);
+        } else {
+            if (!buffer.empty()) spill(buffer);
+            reduceRuns();
+        }
+    }
+
+    /**
+     * @brief Sorts the elements of a container externally.
+     */
+    template <size_t N>
+    explicit ExternalAscendingOrder(const Container<T, N>& c, ExternalSortConfig cfg = {})
+        : ExternalAscendingOrder(Order<T, N>(c), std::move(cfg)) {}
+
+    ExternalAscendingOrder(ExternalAscendingOrder&&) = default;
+    ExternalAscendingOrder& operator=(ExternalAscendingOrder&&) = default;
+
+    /** @brief Returns the number of elements. */
+    size_t size() const { return count; }
+
+    /** @brief Returns the number of runs spilled to disk (0 if everything fitted in memory). */
+    size_t spilledRuns() const { return runs.size(); }
+
+    /**
+     * @brief Starts a new k-way merge and returns an iterator to its first element.
+     *
+     * Each call restarts the merge; iterators of an earlier call become invalid.
+     * Advancing throws std::runtime_error if a spill file cannot be read, rather
+     * than ending the traversal early.
+     */
+    typename Generator<T>::iterator begin() {
+        stream = mergeAll();
+        return stream.begin();
+    }
+
+    std::default_sentinel_t end() const {
+        return std::default_sentinel;
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_EXTERNAL_SORT_HPP
@@ -0,0 +1,132 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_EYTZINGER_ORDER_HPP
+#define MYCONTAINERS_EYTZINGER_ORDER_HPP
+
+#include "Container.hpp"
+#include "Iterator.hpp"
+#include "AdaptiveSort.hpp"
+#include "ViewStorage.hpp"
+#include <cstddef>
+#include <ranges>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * @brief A static search layout of the container: its sorted elements in
+ *        breadth-first (Eytzinger) order, i.e. the order of an implicit binary heap.
+ *
+ * For example, if the container contains [7, 15, 6, 1, 2],
+ * this iterator will yield: 7, 2, 15, 1, 6.
+ *
+ * Position k has its children at 2k and 2k+1 (1-based), so a search walks down
+ * one cache line per level and the next levels can be prefetched before they are
+ * needed. lower_bound() and contains() run without data-dependent branches and
+ * are several times faster than a binary search over the sorted array once the
+ * array no longer fits in cache. The view holds its own copy and stays valid
+ * after the container changes.
+ *
+ * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container (see Container).
+ */
+template <typename T = int, size_t N = 0>
+class EytzingerOrder : public std::ranges::view_interface<EytzingerOrder<T, N>> {
+
+private:
+    detail::ViewStorage<std::vector<T>> layout; ///< layout[1..n] in BFS order; layout[0] is unused so children are 2k and 2k+1
+
+    /** @brief Elements per 64-byte cache line, i.e. how many nodes one prefetch covers. */
+    static constexpr size_t lineElements = sizeof(T) >= 64 ? 1 : 64 / sizeof(T);
+
+    /** @brief Fills the subtree rooted at k of out with sorted[next...], in order. */
+    static void fill(std::vector<T>& out, const T* sorted, size_t& next, size_t k) {
+        // Walk the left spine iteratively; recursion depth is then log2(n) at most.
+        while (k < out.size()) {
+            fill(out, sorted, next, 2 * k);
+            out[k] = sorted[next++];
+            k = 2 * k + 1;
+        }
+    }
+
+    /** @brief Returns the 1-based layout position of the first element not less than value, or 0. */
+    size_t search(const T& value) const {
+        const T* base = layout.get().data();
+        size_t n = layout.get().size() - 1;
+        size_t k = 1;
+        while (k <= n) {
+            // The descendants log2(lineElements) levels down start at k * lineElements
+            // and fill one cache line: fetch it while the next levels are compared.
+            __builtin_prefetch(base + k * lineElements);
+            k = 2 * k + static_cast<size_t>(base[k] < value);
+        }
+        // Undo the trailing right turns plus the last left turn to reach the answer.
+        k >>= __builtin_ffsll(static_cast<long long>(~k));
+        return k;
+    }
+
+public:
+    using const_iterator = Iterator<typename std::vector<T>::const_iterator>;
+
+    /**
+     * @brief Constructor that takes a reference to a container and lays its elements out.
+     *
+     * Sorted storage (a sorted container or its sorted index) is read directly;
+     * otherwise a copy is sorted first. O(n log n), or O(n) from sorted storage.
+     *
+     * @param c The container to lay out.
+     */
+    explicit EytzingerOrder(const Container<T, N>& c) {
+        const auto& data = c.getData();
+        std::vector<T> nodes(data.size() + 1);
+        size_t next = 0;
+        if (c.isSorted()) { // includes the empty container: nothing to fill
+            fill(nodes, data.data(), next, 1);
+        } else if (c.hasSortedIndex()) {
+            fill(nodes, c.getSortedIndex().data(), next, 1);
+        } else {
+            std::vector<T> sorted(data.begin(), data.end());
+            adaptiveSort(sorted.data(), sorted.data() + sorted.size());
+            fill(nodes, sorted.data(), next, 1);
+        }
+        layout = detail::ViewStorage<std::vector<T>>(std::move(nodes));
+    }
+
+    /**
+     * @brief Returns the smallest element not less than value, or nullptr if there is none.
+     *
+     * A pointer rather than an iterator: the next position in the layout is the
+     * next BFS node, not the next larger element, so there is nothing to advance to.
+     * The pointer is valid as long as this view or a copy of it exists.
+     */
+    const T* lower_bound(const T& value) const {
+        size_t k = search(value);
+        return k == 0 ? nullptr : layout.get().data() + k;
+    }
+
+    /**
+     * @brief Returns true if an element equal to value exists.
+     */
+    bool contains(const T& value) const {
+        size_t k = search(value);
+        return k != 0 && !(value < layout.get()[k]);
+    }
+
+    /**
+     * @brief Returns an iterator to the root of the layout.
+     */
+    const_iterator begin() const {
+        return const_iterator(layout.get().begin() + 1, layout.get().end());
+    }
+
+    /**
+     * @brief Returns an iterator past the last position of the layout.
+     */
+    const_iterator end() const {
+        return const_iterator(layout.get().end(), layout.get().end());
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_EYTZINGER_ORDER_HPP
@@ -0,0 +1,322 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_FREQUENCY_ORDER_HPP
+#define MYCONTAINERS_FREQUENCY_ORDER_HPP
+
+#include "Container.hpp"
+#include "Iterator.hpp"
+#include "ViewStorage.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mycontainers {
+
+namespace detail {
+
+/**
+ * @brief Open-addressing counter table with linear probing.
+ *
+ * Keys and counts sit side by side in one flat array, so a probe usually stays
+ * within a single cache line; a count of 0 marks an empty slot. The table
+ * doubles once it is a quarter full: short probe sequences keep the probe loop's
+ * exit branch predictable, which matters more than the extra slots.
+ */
+template <typename T>
+class CountTable {
+private:
+    struct Slot {
+        T key{};
+        size_t count = 0;
+    };
+
+    std::vector<Slot> slots = std::vector<Slot>(16);
+    size_t used = 0;
+    unsigned shift = 60; ///< 64 - log2(slots.size())
+
+    size_t home(const T& value) const {
+        // Fibonacci hashing: the top bits of the product are well mixed even for identity hashes.
+        return (static_cast<uint64_t>(std::hash<T>{}(value)) * 0x9e3779b97f4a7c15ULL) >> shift;
+    }
+
+    Slot& probe(const T& value) {
+        size_t mask = slots.size() - 1;
+        size_t i = home(value);
+        while (slots[i].count != 0 && !(slots[i].key == value)) {
+            i = (i + 1) & mask;
+        }
+        return slots[i];
+    }
+
+    void grow() {
+        std::vector<Slot> old(slots.size() * 2);
+        old.swap(slots);
+        --shift;
+        for (Slot& s : old) {
+            if (s.count != 0) {
+                probe(s.key) = std::move(s);
+            }
+        }
+    }
+
+public:
+    /** @brief Adds n occurrences of value. */
+    void add(const T& value, size_t n = 1) {
+        Slot& s = probe(value);
+        if (s.count == 0) {
+            s.key = value;
+            ++used;
+        }
+        s.count += n;
+        if (4 * used > slots.size()) {
+            grow();
+        }
+    }
+
+    /** @brief Calls fn(key, count) for every key in the table, in no particular order. */
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const Slot& s : slots) {
+            if (s.count != 0) {
+                fn(s.key, s.count);
+            }
+        }
+    }
+
+    /** @brief Number of distinct keys. */
+    size_t size() const {
+        return used;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Requests the bounded-memory, approximate FrequencyOrder with the given number of counters.
+ */
+struct SpaceSaving {
+    size_t counters;
+};
+
+/**
+ * @brief An iterator over (value, count) pairs, most frequent value first.
+ *
+ * For example, if the container contains [7, 1, 15, 7, 1, 7],
+ * this iterator will yield: (7, 3), (1, 2), (15, 1).
+ *
+ * Values with equal counts come out smallest first. Exact counts come from a
+ * run-length scan when the container is sorted or keeps a sorted index, and
+ * otherwise from one pass over an open-addressing hash table. The top-k
+ * constructor orders only the k most frequent values.
+ *
+ * When even one counter per distinct value is too much memory, the
+ * SpaceSaving constructor keeps at most m counters (Metwally et al.): every
+ * value that occurs more than n / m times is guaranteed to be reported, and
+ * each reported count overestimates the true one by at most errorAt(i). It
+ * trades time for memory: each element costs an O(log m) heap update, so it is
+ * slower than the exact table and pays off only when the distinct values do not fit.
+ *
+ * @tparam T The type of the container elements; must be hashable with std::hash.
+ * @tparam N Inline capacity of the container (see Container).
+ */
+template <typename T = int, size_t N = 0>
+class FrequencyOrder : public std::ranges::view_interface<FrequencyOrder<T, N>> {
+
+private:
+    struct Table {
+        std::vector<std::pair<T, size_t>> entries; ///< (value, count), by descending count
+        std::vector<size_t> errors; ///< Overestimate bound per entry; empty for exact counts
+    };
+    detail::ViewStorage<Table> table; ///< Shared by copies of the view
+
+    static bool moreFrequent(const std::pair<T, size_t>& a, const std::pair<T, size_t>& b) {
+        return a.second > b.second || (a.second == b.second && a.first < b.first);
+    }
+
+    static void countExact(Table& t, const Container<T, N>& c) {
+        const auto& data = c.getData();
+        if (c.isSorted() || c.hasSortedIndex()) {
+            const auto& sorted = c.isSorted() ? data : c.getSortedIndex();
+            for (const T& value : sorted) {
+                if (t.entries.empty() || t.entries.back().first < value) {
+                    t.entries.emplace_back(value, 1);
+                } else {
+                    ++t.entries.back().second;
+                }
+            }
+            return;
+        }
+        detail::CountTable<T> counts;
+        for (const T& value : data) {
+            counts.add(value);
+        }
+        t.entries.reserve(counts.size());
+        counts.forEach([&t](const T& value, size_t count) { t.entries.emplace_back(value, count); });
+    }
+
+    /**
+     * @brief Space-saving summary: m counters ordered by a min-heap of counter indices,
+     *        plus an index from value to counter. Heap moves touch only the counter array.
+     */
+    static void countApproximate(Table& t, const Container<T, N>& c, size_t m) {
+        struct Counter {
+            T value;
+            size_t count;
+            size_t error;
+            size_t heapPos;
+        };
+        std::vector<Counter> counters;
+        std::vector<size_t> heap; ///< Counter indices, smallest count on top
+        std::unordered_map<T, size_t> counterOf;
+        counters.reserve(m);
+        heap.reserve(m);
+        counterOf.reserve(2 * m);
+
+        auto place = [&](size_t pos, size_t counter) {
+            heap[pos] = counter;
+            counters[counter].heapPos = pos;
+        };
+        auto siftDown = [&](size_t pos) {
+            size_t moving = heap[pos];
+            while (true) {
+                size_t child = 2 * pos + 1;
+                if (child >= heap.size()) break;
+                if (child + 1 < heap.size() && counters[heap[child + 1]].count < counters[heap[child]].count) ++child;
+                if (!(counters[heap[child]].count < counters[moving].count)) break;
+                place(pos, heap[child]);
+                pos = child;
+            }
+            place(pos, moving);
+        };
+
+        for (const T& value : c.getData()) {
+            auto found = counterOf.find(value);
+            if (found != counterOf.end()) {
+                Counter& counter = counters[found->second];
+                ++counter.count;
+                siftDown(counter.heapPos);
+            } else if (counters.size() < m) {
+                counterOf.emplace(value, counters.size());
+                counters.push_back({value, 1, 0, heap.size()});
+                heap.push_back(counters.size() - 1);
+                size_t pos = heap.size() - 1;
+                while (pos > 0 && counters[heap[pos]].count < counters[heap[(pos - 1) / 2]].count) {
+                    size_t parent = heap[(pos - 1) / 2];
+                    place((pos - 1) / 2, heap[pos]);
+                    place(pos, parent);
+                    pos = (pos - 1) / 2;
+                }
+            } else {
+                // Evict the smallest counter; the newcomer inherits its count as error.
+                size_t victim = heap[0];
+                Counter& counter = counters[victim];
+                counterOf.erase(counter.value);
+                counterOf.emplace(value, victim);
+                counter.value = value;
+                counter.error = counter.count;
+                ++counter.count;
+                siftDown(0);
+            }
+        }
+
+        std::sort(counters.begin(), counters.end(), [](const Counter& a, const Counter& b) {
+            return a.count > b.count || (a.count == b.count && a.value < b.value);
+        });
+        for (const Counter& counter : counters) {
+            t.entries.emplace_back(counter.value, counter.count);
+            t.errors.push_back(counter.error);
+        }
+    }
+
+public:
+    using const_iterator = Iterator<typename std::vector<std::pair<T, size_t>>::const_iterator>;
+
+    /**
+     * @brief Constructor that counts every distinct value exactly.
+     *
+     * @param c The container to count.
+     */
+    explicit FrequencyOrder(const Container<T, N>& c) {
+        Table t;
+        countExact(t, c);
+        std::sort(t.entries.begin(), t.entries.end(), moreFrequent);
+        table = detail::ViewStorage<Table>(std::move(t));
+    }
+
+    /**
+     * @brief Constructor that exposes only the k most frequent values.
+     *
+     * Counting is still exact and O(n); only the k winners are ordered (O(d log k)).
+     *
+     * @param c The container to count.
+     * @param k The maximal number of values to expose.
+     */
+    FrequencyOrder(const Container<T, N>& c, size_t k) {
+        Table t;
+        countExact(t, c);
+        size_t length = std::min(k, t.entries.size());
+        std::partial_sort(t.entries.begin(), t.entries.begin() + length, t.entries.end(), moreFrequent);
+        t.entries.resize(length);
+        table = detail::ViewStorage<Table>(std::move(t));
+    }
+
+    /**
+     * @brief Constructor that estimates the frequencies with a fixed number of counters.
+     *
+     * @param c The container to count.
+     * @param summary How many counters to keep; memory is O(summary.counters).
+     * @throws std::invalid_argument if summary.counters is 0.
+     */
+    FrequencyOrder(const Container<T, N>& c, SpaceSaving summary) {
+        if (summary.counters == 0) {
+            throw std::invalid_argument("Space-saving summary needs at least one counter.");
+        }
+        Table t;
+        countApproximate(t, c, summary.counters);
+        table = detail::ViewStorage<Table>(std::move(t));
+    }
+
+    /** @brief Returns true if the counts are exact. */
+    bool isExact() const {
+        return table.get().errors.empty();
+    }
+
+    /**
+     * @brief Returns by how much the i-th count may exceed the true count (0 when exact).
+     *
+     * @throws std::out_of_range if i >= size().
+     */
+    size_t errorAt(size_t i) const {
+        const Table& t = table.get();
+        if (i >= t.entries.size()) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return t.errors.empty() ? 0 : t.errors[i];
+    }
+
+    /**
+     * @brief Returns an iterator to the most frequent (value, count) pair.
+     */
+    const_iterator begin() const {
+        const auto& entries = table.get().entries;
+        return const_iterator(entries.begin(), entries.end());
+    }
+
+    /**
+     * @brief Returns an iterator past the least frequent pair.
+     */
+    const_iterator end() const {
+        const auto& entries = table.get().entries;
+        return const_iterator(entries.end(), entries.end());
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_FREQUENCY_ORDER_HPP
@@ -0,0 +1,133 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_GENERATOR_HPP
+#define MYCONTAINERS_GENERATOR_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+namespace mycontainers {
+
+/**
+ * @brief A lazily evaluated sequence produced by a coroutine (`co_yield`).
+ *
+ * A minimal stand-in for C++23 std::generator: a move-only input view whose
+ * elements are computed one at a time as the caller advances the iterator,
+ * so producers of unbounded length can be consumed with bounded memory.
+ *
+ * @tparam T The type of the yielded elements.
+ */
+template <typename T>
+class Generator : public std::ranges::view_interface<Generator<T>> {
+
+public:
+    struct promise_type {
+        const T* current = nullptr; ///< The value of the last co_yield, alive while the coroutine is suspended
+        std::exception_ptr error;   ///< Exception escaping the coroutine body, rethrown to the consumer
+
+        Generator get_return_object() {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+
+        /** @brief Reports a failure of the coroutine body to the consumer. */
+        void rethrowIfFailed() {
+            if (error) {
+                std::rethrow_exception(std::exchange(error, nullptr));
+            }
+        }
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    /**
+     * @brief Single-pass iterator over the generated values.
+     */
+    class iterator {
+    private:
+        handle_type coro;
+
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type       = T;
+        using difference_type  = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(handle_type h) : coro(h) {}
+
+        const T& operator*() const {
+            if (!coro || coro.done()) throw std::out_of_range("Cannot dereference end iterator.");
+            return *coro.promise().current;
+        }
+
+        iterator& operator++() {
+            coro.resume();
+            coro.promise().rethrowIfFailed();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) {
+            return !it.coro || it.coro.done();
+        }
+    };
+
+    Generator() = default;
+
+    Generator(Generator&& other) noexcept : coro(std::exchange(other.coro, nullptr)) {}
+
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            if (coro) coro.destroy();
+            coro = std::exchange(other.coro, nullptr);
+        }
+        return *this;
+    }
+
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    ~Generator() {
+        if (coro) coro.destroy();
+    }
+
+    /**
+     * @brief Starts the coroutine and returns an iterator to its first value.
+     *
+     * A generator is single-pass: begin() may be called only once.
+     */
+    iterator begin() {
+        if (coro) {
+            coro.resume();
+            coro.promise().rethrowIfFailed();
+        }
+        return iterator(coro);
+    }
+
+    std::default_sentinel_t end() const noexcept {
+        return std::default_sentinel;
+    }
+
+private:
+    handle_type coro;
+
+    explicit Generator(handle_type h) : coro(h) {}
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_GENERATOR_HPP
@@ -3,6 +3,7 @@
 #ifndef ITERATOR_HPP
 #define ITERATOR_HPP
 
+#include <compare>
 #include <iterator>
 #include <stdexcept>
 
@@ -13,16 +14,19 @@ template <typename Iter>
 class Iterator {
     
 private:
-    Iter it;
-    Iter endIt;
+    Iter it{};
+    Iter endIt{};
 
 public:
-    using iterator_category = std::forward_iterator_tag;
-    using value_type        = typename Iter::value_type;
+    using iterator_concept  = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = std::iter_value_t<Iter>;
     using difference_type   = std::ptrdiff_t;
     using pointer           = const value_type*;
     using reference         = const value_type&;
 
+    Iterator() = default;
+
     Iterator(Iter current, Iter end) : it(current), endIt(end) {}
 
     reference operator*() const {
@@ -35,6 +39,11 @@ public:
         return &(*it);
     }
 
+    reference operator[](difference_type n) const {
+        if (n >= endIt - it) throw std::out_of_range("Cannot dereference past the end iterator.");
+        return it[n];
+    }
+
     Iterator& operator++() {
         ++it;
         return *this;
@@ -46,10 +55,39 @@ public:
         return temp;
     }
 
+    Iterator& operator--() {
+        --it;
+        return *this;
+    }
+
+    Iterator operator--(int) {
+        Iterator temp = *this;
+        --(*this);
+        return temp;
+    }
+
+    Iterator& operator+=(difference_type n) {
+        it += n;
+        return *this;
+    }
+
+    Iterator& operator-=(difference_type n) {
+        it -= n;
+        return *this;
+    }
+
+    friend Iterator operator+(Iterator i, difference_type n) { return i += n; }
+    friend Iterator operator+(difference_type n, Iterator i) { return i += n; }
+    friend Iterator operator-(Iterator i, difference_type n) { return i -= n; }
+    friend difference_type operator-(const Iterator& a, const Iterator& b) { return a.it - b.it; }
+
+    const Iter& base() const { return it; }
+
     bool operator==(const Iterator& other) const { return it == other.it; }
     bool operator!=(const Iterator& other) const { return it != other.it; }
+    auto operator<=>(const Iterator& other) const { return it <=> other.it; }
 };
 
 } // namespace mycontainers
 
-#endif
\ No newline at end of file
+#endif
@@ -5,8 +5,10 @@
 
 #include "Container.hpp"
 #include "Iterator.hpp"
+#include "ViewStorage.hpp"
 #include <vector>
 #include <algorithm>
+#include <ranges>
 #include <stdexcept>
 #include <cmath>
 
@@ -22,28 +24,31 @@ namespace mycontainers {
  * For even-sized containers, the middle is floor(size/2).
  *
  * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container and of the reordered copy.
  */
-template <typename T = int>
-class MiddleOutOrder {
+template <typename T = int, size_t N = 0>
+class MiddleOutOrder : public std::ranges::view_interface<MiddleOutOrder<T, N>> {
 
 private:
-    std::vector<T> middleOutData; ///< Container's data reordered in middle-out order
+    detail::ViewStorage<typename Container<T, N>::storage_type, N == 0> middleOutData; ///< Container's data reordered in middle-out order
 
 public:
+    using const_iterator = Iterator<typename Container<T, N>::storage_type::const_iterator>;
+
     /**
      * @brief Constructor that takes a reference to a container and
      *        reorders its data in middle-out order.
      *
      * @param c The container to iterate over.
      */
-    explicit MiddleOutOrder(const Container<T>& c) {
+    explicit MiddleOutOrder(const Container<T, N>& c) {
         const auto& data = c.getData();
     
         if (data.empty()) {
             return; // allow empty traversal (begin == end)
         }
     
-        std::vector<T> temp = data;    
+        const auto& temp = data;    
         size_t n = temp.size();
         int mid=0;
         if (n%2==0) {
@@ -52,35 +57,38 @@ public:
             mid = (n-1) / 2;
         }
     
-        middleOutData.push_back(temp[mid]);
+        typename Container<T, N>::storage_type reordered;
+        reordered.reserve(n);
+        reordered.push_back(temp[mid]);
     
         int offset = 1;
         while ((mid - offset) >= 0 || (mid + offset) < static_cast<int>(n)) {
             if ((mid - offset) >= 0) {
-                middleOutData.push_back(temp[mid - offset]);
+                reordered.push_back(temp[mid - offset]);
             }
             if ((mid + offset) < static_cast<int>(n)) {
-                middleOutData.push_back(temp[mid + offset]);
+                reordered.push_back(temp[mid + offset]);
             }
             ++offset;
         }
+        middleOutData = detail::ViewStorage<typename Container<T, N>::storage_type, N == 0>(std::move(reordered));
         std::cout << std::endl;
     }
 
     /**
      * @brief Returns an iterator to the beginning of the MiddleOut-ordered container.
      */
-    Iterator<typename std::vector<T>::const_iterator> begin() const {
-        return Iterator<typename std::vector<T>::const_iterator>(
-            middleOutData.begin(), middleOutData.end());
+    const_iterator begin() const {
+        return const_iterator(
+            middleOutData.get().begin(), middleOutData.get().end());
     }
 
     /**
      * @brief Returns an iterator to the end of the MiddleOut-ordered container.
      */
-    Iterator<typename std::vector<T>::const_iterator> end() const {
-        return Iterator<typename std::vector<T>::const_iterator>(
-            middleOutData.end(), middleOutData.end());
+    const_iterator end() const {
+        return const_iterator(
+            middleOutData.get().end(), middleOutData.get().end());
     }
 };
 
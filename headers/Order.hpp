@@ -7,6 +7,7 @@
 #include "Iterator.hpp"
 
 #include <vector>
+#include <ranges>
 
 namespace mycontainers {
 
@@ -17,36 +18,37 @@ namespace mycontainers {
  * this iterator will yield: 7, 15, 6, 1, 2.
  * 
  * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container (see Container).
  */
-template <typename T = int>
+template <typename T = int, size_t N = 0>
 
-class Order {
+class Order : public std::ranges::view_interface<Order<T, N>> {
     
 private:
-    const Container<T>& container; ///< Reference to the container being iterated
+    const Container<T, N>* container; ///< The container being iterated (a pointer, so the view stays assignable)
 
 public:
-    using const_iterator = Iterator<typename std::vector<T>::const_iterator>;
+    using const_iterator = Iterator<typename Container<T, N>::storage_type::const_iterator>;
 
     /**
      * @brief Constructor that receives a reference to the container.
      * 
      * @param c The container to iterate over.
      */
-    explicit Order(const Container<T>& c) : container(c) {}
+    explicit Order(const Container<T, N>& c) : container(&c) {}
 
     /**
      * @brief Returns an iterator to the beginning of the container.
      */
     const_iterator begin() const {
-        return const_iterator(container.getData().begin(), container.getData().end());
+        return const_iterator(container->getData().begin(), container->getData().end());
     }
 
     /**
      * @brief Returns an iterator to the end of the container.
      */
     const_iterator end() const {
-        return const_iterator(container.getData().end(), container.getData().end());
+        return const_iterator(container->getData().end(), container->getData().end());
     }
 };
 
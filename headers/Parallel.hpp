@@ -0,0 +1,171 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_PARALLEL_HPP
+#define MYCONTAINERS_PARALLEL_HPP
+
+#include "ThreadPool.hpp"
+#include "ChunkedIteration.hpp"
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * @brief Splits a random-access view into parts consecutive sub-ranges whose sizes differ by at most one.
+ *
+ * Every order view is random-access, so each boundary is one iterator
+ * addition: O(parts) in total, independent of the view's size. Some parts
+ * are empty when parts > size.
+ *
+ * @throws std::invalid_argument if parts is 0.
+ */
+template <std::ranges::random_access_range View>
+    requires std::ranges::sized_range<const View>
+auto split(const View& view, size_t parts) {
+    using It = std::ranges::iterator_t<const View>;
+    if (parts == 0) {
+        throw std::invalid_argument("Cannot split into zero parts.");
+    }
+    size_t size = static_cast<size_t>(std::ranges::size(view));
+    It first = std::ranges::begin(view);
+    std::vector<std::ranges::subrange<It>> result;
+    result.reserve(parts);
+    size_t offset = 0;
+    for (size_t p = 0; p < parts; ++p) {
+        size_t length = size / parts + (p < size % parts ? 1 : 0);
+        result.emplace_back(first + static_cast<std::ptrdiff_t>(offset),
+                            first + static_cast<std::ptrdiff_t>(offset + length));
+        offset += length;
+    }
+    return result;
+}
+
+namespace detail {
+
+/** @brief Elements below which another worker costs more than it saves. */
+constexpr size_t parallelMinPart = 16384;
+
+template <typename View>
+size_t parallelParts(const View& view, const ThreadPool& pool) {
+    size_t size = static_cast<size_t>(std::ranges::size(view));
+    // The caller works too, so the pool's workers plus one share the range.
+    return std::max<size_t>(1, std::min(pool.size() + 1, size / parallelMinPart));
+}
+
+/**
+ * @brief Runs part(i) for every part, parts 1.. on the pool and part 0 on the caller,
+ *        and waits for all of them before rethrowing the first exception.
+ *
+ * While a part is still pending the caller runs queued pool tasks itself
+ * instead of blocking, so a nested call from inside a part (whose caller is a
+ * pool worker) cannot leave every worker waiting on tasks nobody runs.
+ */
+template <typename Part>
+void runParts(size_t parts, ThreadPool& pool, Part part) {
+    std::vector<std::future<void>> pending;
+    pending.reserve(parts - 1);
+    for (size_t i = 1; i < parts; ++i) {
+        pending.push_back(pool.submit([&part, i] { part(i); }));
+    }
+    std::exception_ptr failure;
+    try {
+        part(0);
+    } catch (...) {
+        failure = std::current_exception();
+    }
+    for (auto& future : pending) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            // An empty queue means the part is already running on some thread.
+            if (!pool.tryRunOne()) {
+                future.wait();
+            }
+        }
+        try {
+            future.get();
+        } catch (...) {
+            if (!failure) failure = std::current_exception();
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Calls fn(element) for every element of the view, spreading the view over the pool.
+ *
+ * The view is split into one part per worker plus one for the calling thread;
+ * each part walks the raw iterators under the view's checked ones. fn runs
+ * concurrently and must be safe to call from several threads. Views under
+ * 2 x 16384 elements run on the caller alone.
+ *
+ * @throws Whatever fn throws (the first failure, after every part has stopped).
+ */
+template <std::ranges::random_access_range View, typename Fn>
+    requires std::ranges::sized_range<const View>
+void parallel_for_each(const View& view, Fn fn, ThreadPool& pool = ThreadPool::shared()) {
+    auto parts = split(view, detail::parallelParts(view, pool));
+    detail::runParts(parts.size(), pool, [&](size_t i) {
+        auto last = detail::rawIterator(parts[i].end());
+        for (auto it = detail::rawIterator(parts[i].begin()); it != last; ++it) {
+            fn(*it);
+        }
+    });
+}
+
+/**
+ * @brief Reduces transform(element) over the view with reduce, starting from init, in parallel.
+ *
+ * Each part folds its own elements, then the part results are folded into
+ * init in view order, so reduce must be associative but need not be
+ * commutative or have an identity; the result does not depend on the number
+ * of threads for exact operations (for floating point it may differ in rounding).
+ *
+ * @param view The view to reduce.
+ * @param init Initial value; the result has its type.
+ * @param reduce Associative binary operation, e.g. std::plus<>().
+ * @param transform Applied to every element first, e.g. std::identity().
+ * @param pool The pool that runs the parts.
+ */
+template <std::ranges::random_access_range View, typename R,
+          typename Reduce = std::plus<>, typename Transform = std::identity>
+    requires std::ranges::sized_range<const View>
+R parallel_reduce(const View& view, R init, Reduce reduce = {}, Transform transform = {},
+                  ThreadPool& pool = ThreadPool::shared()) {
+    auto parts = split(view, detail::parallelParts(view, pool));
+    std::vector<std::optional<R>> partial(parts.size());
+    detail::runParts(parts.size(), pool, [&](size_t i) {
+        auto it = detail::rawIterator(parts[i].begin());
+        auto last = detail::rawIterator(parts[i].end());
+        if (it == last) {
+            return;
+        }
+        R acc = static_cast<R>(transform(*it));
+        for (++it; it != last; ++it) {
+            acc = reduce(std::move(acc), transform(*it));
+        }
+        partial[i] = std::move(acc);
+    });
+    for (auto& p : partial) {
+        if (p) {
+            init = reduce(std::move(init), std::move(*p));
+        }
+    }
+    return init;
+}
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_PARALLEL_HPP
@@ -0,0 +1,381 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_PERSISTENT_CONTAINER_HPP
+#define MYCONTAINERS_PERSISTENT_CONTAINER_HPP
+
+#include "Container.hpp"
+#include "Iterator.hpp"
+#include "SimdKernels.hpp"
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * @brief An immutable container whose add() and remove() return new versions.
+ *
+ * Elements are stored in a 32-way trie of shared nodes plus a tail leaf, as in
+ * Clojure's persistent vector. add() copies only the tail, or the O(log32 n)
+ * path to the new leaf, so every version shares all other nodes with its
+ * predecessor; keeping N versions costs O(N log n) extra memory instead of
+ * O(N n). remove() shares every leaf before the first removed element.
+ *
+ * A version is a cheap handle: copying it shares the whole trie. The order
+ * views work on flat(), a Container copy that belongs to the caller (the pipe
+ * adaptors keep one alive per view), so versions never hold flat copies.
+ *
+ * @tparam T The type of elements stored in the container.
+ */
+template <typename T = int>
+class PersistentContainer {
+
+private:
+    static constexpr size_t bits = 5;
+    static constexpr size_t width = size_t(1) << bits; ///< Children per inner node, elements per leaf
+    static constexpr size_t mask = width - 1;
+
+    /**
+     * @brief A trie node: inner nodes hold children, leaves hold up to width elements.
+     */
+    struct Node {
+        std::vector<std::shared_ptr<const Node>> children;
+        std::vector<T> values;
+    };
+    using NodePtr = std::shared_ptr<const Node>;
+
+    /**
+     * @brief One immutable version; shared by every handle that refers to it.
+     */
+    struct Version {
+        NodePtr root; ///< Inner nodes; null until the first leaf is committed
+        NodePtr tail; ///< The last leaf, kept outside the trie (may be full); null when empty
+        size_t count = 0;
+        size_t shift = bits; ///< Bits consumed by the root level
+
+        /** @brief Index of the first element stored in the tail. */
+        size_t tailOffset() const {
+            return count < width ? 0 : ((count - 1) >> bits) << bits;
+        }
+
+        /** @brief Returns the leaf holding element i. */
+        const Node& leafFor(size_t i) const {
+            if (i >= tailOffset()) {
+                return *tail;
+            }
+            const Node* node = root.get();
+            for (size_t level = shift; level > 0; level -= bits) {
+                node = node->children[(i >> level) & mask].get();
+            }
+            return *node;
+        }
+    };
+
+    std::shared_ptr<const Version> version = std::make_shared<const Version>(); ///< The version this handle refers to
+
+    explicit PersistentContainer(std::shared_ptr<const Version> v) : version(std::move(v)) {}
+
+    /** @brief Returns a chain of single-child inner nodes of the given height, ending at leaf. */
+    static NodePtr newPath(size_t level, NodePtr leaf) {
+        if (level == 0) {
+            return leaf;
+        }
+        auto node = std::make_shared<Node>();
+        node->children.push_back(newPath(level - bits, std::move(leaf)));
+        return node;
+    }
+
+    /** @brief Copies the path from parent down to the slot of leaf, which becomes element count - width. */
+    static NodePtr pushTail(size_t count, size_t level, const Node& parent, NodePtr leaf) {
+        auto node = std::make_shared<Node>(parent);
+        size_t slot = ((count - 1) >> level) & mask;
+        NodePtr inserted;
+        if (level == bits) {
+            inserted = std::move(leaf);
+        } else if (slot < parent.children.size()) {
+            inserted = pushTail(count, level - bits, *parent.children[slot], std::move(leaf));
+        } else {
+            inserted = newPath(level - bits, std::move(leaf));
+        }
+        if (slot < node->children.size()) {
+            node->children[slot] = std::move(inserted);
+        } else {
+            node->children.push_back(std::move(inserted));
+        }
+        return node;
+    }
+
+    /**
+     * @brief Moves the full tail of v into the trie, growing the root when it is full.
+     */
+    static void commitTail(Version& v) {
+        if ((v.count >> bits) > (size_t(1) << v.shift)) {
+            auto root = std::make_shared<Node>();
+            root->children.push_back(v.root);
+            root->children.push_back(newPath(v.shift, v.tail));
+            v.root = std::move(root);
+            v.shift += bits;
+        } else {
+            v.root = pushTail(v.count, v.shift, v.root ? *v.root : Node(), v.tail);
+        }
+    }
+
+    /**
+     * @brief Appends a full leaf to a version under construction, sharing the leaf itself.
+     */
+    static void appendLeaf(Version& v, NodePtr leaf) {
+        if (v.count > 0) {
+            commitTail(v);
+        }
+        v.tail = std::move(leaf);
+        v.count += width;
+    }
+
+    /** @brief Returns the number of leaves, counting the tail. */
+    size_t leafCount() const {
+        return (version->count + width - 1) / width;
+    }
+
+    /** @brief Returns the elements of leaf number l. */
+    const std::vector<T>& leafValues(size_t l) const {
+        return version->leafFor(l * width).values;
+    }
+
+    /**
+     * @brief Random-access position inside the trie.
+     */
+    class Cursor {
+    private:
+        const Version* owner = nullptr;
+        size_t index = 0;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        Cursor() = default;
+        Cursor(const Version* v, size_t i) : owner(v), index(i) {}
+
+        reference operator*() const { return owner->leafFor(index).values[index & mask]; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        Cursor& operator++() { ++index; return *this; }
+        Cursor operator++(int) { Cursor t = *this; ++index; return t; }
+        Cursor& operator--() { --index; return *this; }
+        Cursor operator--(int) { Cursor t = *this; --index; return t; }
+        Cursor& operator+=(difference_type n) { index += n; return *this; }
+        Cursor& operator-=(difference_type n) { index -= n; return *this; }
+
+        friend Cursor operator+(Cursor c, difference_type n) { return c += n; }
+        friend Cursor operator+(difference_type n, Cursor c) { return c += n; }
+        friend Cursor operator-(Cursor c, difference_type n) { return c -= n; }
+        friend difference_type operator-(const Cursor& a, const Cursor& b) {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+
+        bool operator==(const Cursor& other) const { return index == other.index; }
+        auto operator<=>(const Cursor& other) const { return index <=> other.index; }
+    };
+
+public:
+    using const_iterator = Iterator<Cursor>;
+
+    /** @brief Default constructor. Creates the empty version. */
+    PersistentContainer() = default;
+
+    /**
+     * @brief Returns a new version with value appended; this version is unchanged.
+     *
+     * Copies the tail leaf, plus one path of at most log32(n) inner nodes when
+     * the tail is full. Everything else is shared with this version.
+     *
+     * @param value The element to add.
+     * @return PersistentContainer The new version.
+     */
+    PersistentContainer add(const T& value) const {
+        auto next = std::make_shared<Version>();
+        next->root = version->root;
+        next->shift = version->shift;
+        next->count = version->count;
+        if (version->count - version->tailOffset() < width) {
+            auto tail = std::make_shared<Node>();
+            tail->values.reserve(width);
+            if (version->tail) {
+                tail->values = version->tail->values;
+            }
+            tail->values.push_back(value);
+            next->tail = std::move(tail);
+        } else {
+            next->tail = version->tail;
+            commitTail(*next);
+            auto tail = std::make_shared<Node>();
+            tail->values.reserve(width);
+            tail->values.push_back(value);
+            next->tail = std::move(tail);
+        }
+        ++next->count;
+        return PersistentContainer(std::move(next));
+    }
+
+    /**
+     * @brief Returns a new version without any occurrence of value; this version is unchanged.
+     *
+     * Leaves before the first occurrence are shared; the rest is rebuilt.
+     *
+     * @param value The element to remove.
+     * @return PersistentContainer The new version.
+     * @throws std::runtime_error if the element is not found.
+     */
+    PersistentContainer remove(const T& value) const {
+        size_t firstLeaf = leafCount();
+        for (size_t l = 0; l < leafCount(); ++l) {
+            const auto& values = leafValues(l);
+            if (simd::contains(values.data(), values.size(), value)) {
+                firstLeaf = l;
+                break;
+            }
+        }
+        if (firstLeaf == leafCount()) {
+            throw std::runtime_error("Element not found in container.");
+        }
+
+        auto next = std::make_shared<Version>();
+        for (size_t l = 0; l < firstLeaf; ++l) {
+            appendLeaf(*next, l * width >= version->tailOffset() ? version->tail
+                                                                 : sharedLeaf(l));
+        }
+        std::vector<T> pending;
+        pending.reserve(width);
+        for (size_t l = firstLeaf; l < leafCount(); ++l) {
+            for (const T& element : leafValues(l)) {
+                if (element != value) {
+                    pending.push_back(element);
+                    if (pending.size() == width) {
+                        auto leaf = std::make_shared<Node>();
+                        leaf->values = std::move(pending);
+                        appendLeaf(*next, std::move(leaf));
+                        pending = std::vector<T>();
+                        pending.reserve(width);
+                    }
+                }
+            }
+        }
+        if (!pending.empty()) {
+            if (next->count > 0) {
+                commitTail(*next);
+            }
+            auto tail = std::make_shared<Node>();
+            tail->values = std::move(pending);
+            next->count += tail->values.size();
+            next->tail = std::move(tail);
+        }
+        return PersistentContainer(std::move(next));
+    }
+
+    /**
+     * @brief Returns the number of elements in this version.
+     */
+    size_t size() const {
+        return version->count;
+    }
+
+    /**
+     * @brief Returns the element at position i in O(log32 n).
+     *
+     * @throws std::out_of_range if i >= size().
+     */
+    const T& at(size_t i) const {
+        if (i >= version->count) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return version->leafFor(i).values[i & mask];
+    }
+
+    /**
+     * @brief Returns the number of elements equal to the given value.
+     */
+    size_t count(const T& value) const {
+        size_t matches = 0;
+        for (size_t l = 0; l < leafCount(); ++l) {
+            const auto& values = leafValues(l);
+            matches += simd::count(values.data(), values.size(), value);
+        }
+        return matches;
+    }
+
+    /**
+     * @brief Returns true if at least one element equals the given value.
+     */
+    bool contains(const T& value) const {
+        for (size_t l = 0; l < leafCount(); ++l) {
+            const auto& values = leafValues(l);
+            if (simd::contains(values.data(), values.size(), value)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Returns this version as a new Container, for the order views. O(n).
+     *
+     * Nothing is cached with the version, so keeping many versions never keeps
+     * many flat copies alive; the caller owns the result.
+     */
+    Container<T> flat() const {
+        Container<T> result;
+        for (size_t l = 0; l < leafCount(); ++l) {
+            for (const T& element : leafValues(l)) {
+                result.add(element);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns an iterator to the first element, in insertion order.
+     */
+    const_iterator begin() const {
+        return const_iterator(Cursor(version.get(), 0), Cursor(version.get(), version->count));
+    }
+
+    /**
+     * @brief Returns an iterator past the last element.
+     */
+    const_iterator end() const {
+        return const_iterator(Cursor(version.get(), version->count), Cursor(version.get(), version->count));
+    }
+
+    /**
+     * @brief Overloads the stream output operator to print the container.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const PersistentContainer& c) {
+        os << "[";
+        for (size_t i = 0; i < c.size(); ++i) {
+            os << c.at(i);
+            if (i + 1 < c.size()) os << ", ";
+        }
+        os << "]";
+        return os;
+    }
+
+private:
+    /** @brief Returns the trie node of leaf number l (which must not be the tail). */
+    NodePtr sharedLeaf(size_t l) const {
+        size_t i = l * width;
+        const NodePtr* node = &version->root;
+        for (size_t level = version->shift; level > 0; level -= bits) {
+            node = &(*node)->children[(i >> level) & mask];
+        }
+        return *node;
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_PERSISTENT_CONTAINER_HPP
@@ -6,7 +6,8 @@
 #include "Container.hpp"
 #include "Iterator.hpp"
 #include <vector>
-#include <algorithm>
+#include <ranges>
+#include <iterator>
 
 namespace mycontainers {
 
@@ -16,50 +17,47 @@ namespace mycontainers {
  * For example, if the container contains [7, 15, 6, 1, 2],
  * this iterator will yield: 2, 1, 6, 15, 7.
  *
+ * The view walks the container's storage backwards and copies nothing, so
+ * construction is O(1). Like Order, it must not outlive the container.
+ *
  * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container (see Container).
  */
-template <typename T = int>
-class ReverseOrder {
+template <typename T = int, size_t N = 0>
+class ReverseOrder : public std::ranges::view_interface<ReverseOrder<T, N>> {
 
 private:
-    std::vector<T> reversedData; ///< Reversed copy of the container's data
+    const Container<T, N>* container; ///< The container being iterated (a pointer, so the view stays assignable)
 
 public:
+    using const_iterator = Iterator<std::reverse_iterator<typename Container<T, N>::storage_type::const_iterator>>;
+
     /**
-     * @brief Constructor that takes a reference to a container and copies its data in reverse.
+     * @brief Constructor that receives a reference to the container.
      * 
      * @param c The container to iterate over in reverse order.
      */
-    explicit ReverseOrder(const Container<T>& c) {
-        const auto& data = c.getData();
-
-        if (data.empty()) {
-            return; // allow empty traversal (begin == end)
-        }
-        
-        reversedData = data;
-        std::reverse(reversedData.begin(), reversedData.end());
-    }
+    explicit ReverseOrder(const Container<T, N>& c) : container(&c) {}
 
     /**
      * @brief Returns an iterator to the beginning of the reversed container.
      * 
-     * @return Iterator to the first element in reverse order.
+     * @return Iterator to the last inserted element.
      */
-    Iterator<typename std::vector<T>::const_iterator> begin() const {
-        return Iterator<typename std::vector<T>::const_iterator>(reversedData.begin(), reversedData.end());
+    const_iterator begin() const {
+        return const_iterator(container->getData().rbegin(), container->getData().rend());
     }
 
     /**
      * @brief Returns an iterator to the end of the reversed container.
      * 
-     * @return Iterator past the last element in reverse order.
+     * @return Iterator past the first inserted element.
      */
-    Iterator<typename std::vector<T>::const_iterator> end() const {
-        return Iterator<typename std::vector<T>::const_iterator>(reversedData.end(), reversedData.end());
+    const_iterator end() const {
+        return const_iterator(container->getData().rend(), container->getData().rend());
     }
 };
 
 } // namespace mycontainers
 
-#endif // MYCONTAINERS_REVERSE_ORDER_HPP
\ No newline at end of file
+#endif // MYCONTAINERS_REVERSE_ORDER_HPP
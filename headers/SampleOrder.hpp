@@ -0,0 +1,152 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_SAMPLE_ORDER_HPP
+#define MYCONTAINERS_SAMPLE_ORDER_HPP
+
+#include "Container.hpp"
+#include "Iterator.hpp"
+#include "ViewStorage.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <unordered_set>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * @brief An iterator over a uniform random sample of k elements, in container order.
+ *
+ * For example, if the container contains [7, 15, 6, 1, 2], a sample of 3 may
+ * yield 7, 1, 2: every 3-element subset is equally likely, and the elements
+ * keep their relative order. A sample of k >= n yields the whole container.
+ *
+ * Only the k sampled positions are stored. They are drawn with Floyd's
+ * algorithm (k draws, no rejection loop, no pass over the data) and sorted, so
+ * construction is O(k log k) regardless of n. The same seed draws the same
+ * sample on every platform. Like Order, the view reads the container's
+ * storage, must not outlive the container and is invalidated by add() and remove().
+ *
+ * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container (see Container).
+ */
+template <typename T = int, size_t N = 0>
+class SampleOrder : public std::ranges::view_interface<SampleOrder<T, N>> {
+
+private:
+    /**
+     * @brief Random-access position in the list of sampled indices.
+     */
+    class Cursor {
+    private:
+        const T* data = nullptr;
+        const size_t* position = nullptr;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        Cursor() = default;
+        Cursor(const T* d, const size_t* p) : data(d), position(p) {}
+
+        reference operator*() const { return data[*position]; }
+        reference operator[](difference_type n) const { return data[position[n]]; }
+
+        Cursor& operator++() { ++position; return *this; }
+        Cursor operator++(int) { Cursor t = *this; ++position; return t; }
+        Cursor& operator--() { --position; return *this; }
+        Cursor operator--(int) { Cursor t = *this; --position; return t; }
+        Cursor& operator+=(difference_type n) { position += n; return *this; }
+        Cursor& operator-=(difference_type n) { position -= n; return *this; }
+
+        friend Cursor operator+(Cursor c, difference_type n) { return c += n; }
+        friend Cursor operator+(difference_type n, Cursor c) { return c += n; }
+        friend Cursor operator-(Cursor c, difference_type n) { return c -= n; }
+        friend difference_type operator-(const Cursor& a, const Cursor& b) { return a.position - b.position; }
+
+        bool operator==(const Cursor& other) const { return position == other.position; }
+        auto operator<=>(const Cursor& other) const { return position <=> other.position; }
+    };
+
+    const T* data = nullptr;     ///< The container's elements
+    detail::ViewStorage<std::vector<size_t>> indices; ///< Sampled positions, ascending
+
+    static uint64_t splitmix(uint64_t& state) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /** @brief Uniform draw from [0, bound) by multiply-shift (Lemire); the bias is bound / 2^64, negligible here. */
+    static size_t below(uint64_t& state, size_t bound) {
+        return static_cast<size_t>((static_cast<unsigned __int128>(splitmix(state)) * bound) >> 64);
+    }
+
+public:
+    using const_iterator = Iterator<Cursor>;
+
+    /**
+     * @brief Constructor that draws k positions of the container.
+     *
+     * @param c The container to sample.
+     * @param k The sample size; capped at the container size.
+     * @param seed Selects the sample; equal seeds give equal samples.
+     */
+    SampleOrder(const Container<T, N>& c, size_t k, uint64_t seed) : data(c.getData().data()) {
+        size_t n = c.size();
+        std::vector<size_t> picked;
+        if (k >= n) {
+            picked.resize(n);
+            std::iota(picked.begin(), picked.end(), size_t(0));
+        } else {
+            // Floyd: after handling j, chosen is a uniform subset of [0, j] with j - (n - k) + 1 elements.
+            std::unordered_set<size_t> chosen;
+            chosen.reserve(2 * k);
+            picked.reserve(k);
+            for (size_t j = n - k; j < n; ++j) {
+                size_t t = below(seed, j + 1);
+                size_t pick = chosen.insert(t).second ? t : j;
+                if (pick == j) {
+                    chosen.insert(j);
+                }
+                picked.push_back(pick);
+            }
+            std::sort(picked.begin(), picked.end());
+        }
+        indices = detail::ViewStorage<std::vector<size_t>>(std::move(picked));
+    }
+
+    /**
+     * @brief Returns the sampled positions in the container, ascending.
+     */
+    const std::vector<size_t>& getIndices() const {
+        return indices.get();
+    }
+
+    /**
+     * @brief Returns an iterator to the first sampled element.
+     */
+    const_iterator begin() const {
+        const auto& positions = indices.get();
+        return const_iterator(Cursor(data, positions.data()), Cursor(data, positions.data() + positions.size()));
+    }
+
+    /**
+     * @brief Returns an iterator past the last sampled element.
+     */
+    const_iterator end() const {
+        const size_t* last = indices.get().data() + indices.get().size();
+        return const_iterator(Cursor(data, last), Cursor(data, last));
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_SAMPLE_ORDER_HPP
@@ -0,0 +1,258 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_SEGMENTED_CONTAINER_HPP
+#define MYCONTAINERS_SEGMENTED_CONTAINER_HPP
+
+#include "Iterator.hpp"
+#include "SimdKernels.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * @brief A container that stores its elements in fixed-size chunks instead of one vector.
+ *
+ * Appending never moves existing elements: when the last chunk is full a new
+ * one is allocated and registered in a small directory of chunk pointers. This
+ * keeps element addresses stable across add(), makes the worst-case append O(1)
+ * element copies, and avoids the peak of old + new buffer that a growing vector
+ * pays when it reallocates. Iteration walks chunk by chunk.
+ *
+ * @tparam T The type of elements stored in the container.
+ * @tparam ChunkSize Number of elements per chunk.
+ */
+template <typename T = int, size_t ChunkSize = 4096>
+class SegmentedContainer {
+    static_assert(ChunkSize > 0, "ChunkSize must be positive.");
+
+private:
+    std::vector<std::unique_ptr<std::vector<T>>> chunks; ///< Directory of chunks; each holds at most ChunkSize elements
+    size_t total = 0; ///< Total number of elements
+
+    /**
+     * @brief Random-access position inside the chunk directory.
+     */
+    class Cursor {
+    private:
+        const SegmentedContainer* owner = nullptr;
+        size_t index = 0;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        Cursor() = default;
+        Cursor(const SegmentedContainer* c, size_t i) : owner(c), index(i) {}
+
+        reference operator*() const { return (*owner->chunks[index / ChunkSize])[index % ChunkSize]; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        Cursor& operator++() { ++index; return *this; }
+        Cursor operator++(int) { Cursor t = *this; ++index; return t; }
+        Cursor& operator--() { --index; return *this; }
+        Cursor operator--(int) { Cursor t = *this; --index; return t; }
+        Cursor& operator+=(difference_type n) { index += n; return *this; }
+        Cursor& operator-=(difference_type n) { index -= n; return *this; }
+
+        friend Cursor operator+(Cursor c, difference_type n) { return c += n; }
+        friend Cursor operator+(difference_type n, Cursor c) { return c += n; }
+        friend Cursor operator-(Cursor c, difference_type n) { return c -= n; }
+        friend difference_type operator-(const Cursor& a, const Cursor& b) {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+
+        bool operator==(const Cursor& other) const { return index == other.index; }
+        auto operator<=>(const Cursor& other) const { return index <=> other.index; }
+    };
+
+public:
+    using const_iterator = Iterator<Cursor>;
+
+    /** @brief Default constructor. Initializes an empty container. */
+    SegmentedContainer() = default;
+
+    /**
+     * @brief Copy constructor. Copies every chunk.
+     *
+     * @param other The container to copy from.
+     */
+    SegmentedContainer(const SegmentedContainer& other) : total(other.total) {
+        chunks.reserve(other.chunks.size());
+        for (const auto& chunk : other.chunks) {
+            auto copy = std::make_unique<std::vector<T>>();
+            copy->reserve(ChunkSize);
+            copy->assign(chunk->begin(), chunk->end());
+            chunks.push_back(std::move(copy));
+        }
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     *
+     * @param other The container to assign from.
+     * @return SegmentedContainer& Reference to this container.
+     */
+    SegmentedContainer& operator=(const SegmentedContainer& other) {
+        if (this != &other) {
+            SegmentedContainer copy(other);
+            chunks.swap(copy.chunks);
+            total = copy.total;
+        }
+        return *this;
+    }
+
+    SegmentedContainer(SegmentedContainer&&) noexcept = default;
+    SegmentedContainer& operator=(SegmentedContainer&&) noexcept = default;
+
+    /** @brief Destructor. Releases every chunk. */
+    ~SegmentedContainer() = default;
+
+    /**
+     * @brief Adds a new element at the end, allocating a new chunk when the last one is full.
+     *
+     * Never moves existing elements, so references to them stay valid.
+     *
+     * @param value The element to add.
+     */
+    void add(const T& value) {
+        if (total % ChunkSize == 0) {
+            auto chunk = std::make_unique<std::vector<T>>();
+            chunk->reserve(ChunkSize);
+            chunks.push_back(std::move(chunk));
+        }
+        chunks.back()->push_back(value);
+        ++total;
+    }
+
+    /**
+     * @brief Removes all occurrences of the given element, keeping the order of the rest.
+     *
+     * Later elements shift forward across chunk boundaries; emptied chunks are released.
+     *
+     * @param value The element to remove.
+     * @throws std::runtime_error if the element is not found.
+     */
+    void remove(const T& value) {
+        size_t out = 0;
+        size_t in = 0;
+        for (auto& chunk : chunks) {
+            for (T& element : *chunk) {
+                if (element != value) {
+                    if (out != in) {
+                        (*chunks[out / ChunkSize])[out % ChunkSize] = std::move(element);
+                    }
+                    ++out;
+                }
+                ++in;
+            }
+        }
+        if (out == total) {
+            throw std::runtime_error("Element not found in container.");
+        }
+        total = out;
+        size_t keptChunks = (total + ChunkSize - 1) / ChunkSize;
+        chunks.resize(keptChunks);
+        if (keptChunks > 0) {
+            chunks.back()->resize(total - (keptChunks - 1) * ChunkSize);
+        }
+    }
+
+    /**
+     * @brief Returns the number of elements in the container.
+     */
+    size_t size() const {
+        return total;
+    }
+
+    /**
+     * @brief Returns the number of elements equal to the given value.
+     */
+    size_t count(const T& value) const {
+        size_t matches = 0;
+        for (const auto& chunk : chunks) {
+            if constexpr (simd::is_vectorizable_v<T>) {
+                matches += simd::count(chunk->data(), chunk->size(), value);
+            } else {
+                matches += static_cast<size_t>(std::count(chunk->begin(), chunk->end(), value));
+            }
+        }
+        return matches;
+    }
+
+    /**
+     * @brief Returns true if at least one element equals the given value.
+     */
+    bool contains(const T& value) const {
+        for (const auto& chunk : chunks) {
+            if constexpr (simd::is_vectorizable_v<T>) {
+                if (simd::contains(chunk->data(), chunk->size(), value)) return true;
+            } else {
+                if (std::find(chunk->begin(), chunk->end(), value) != chunk->end()) return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Returns the number of chunks currently allocated.
+     */
+    size_t chunkCount() const {
+        return chunks.size();
+    }
+
+    /**
+     * @brief Returns the elements of chunk i as a contiguous span.
+     *
+     * @throws std::out_of_range if i >= chunkCount().
+     */
+    std::span<const T> chunk(size_t i) const {
+        if (i >= chunks.size()) {
+            throw std::out_of_range("Chunk index out of range.");
+        }
+        return std::span<const T>(chunks[i]->data(), chunks[i]->size());
+    }
+
+    /**
+     * @brief Returns an iterator to the first element, in insertion order.
+     */
+    const_iterator begin() const {
+        return const_iterator(Cursor(this, 0), Cursor(this, total));
+    }
+
+    /**
+     * @brief Returns an iterator past the last element.
+     */
+    const_iterator end() const {
+        return const_iterator(Cursor(this, total), Cursor(this, total));
+    }
+
+    /**
+     * @brief Overloads the stream output operator to print the container.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const SegmentedContainer& c) {
+        os << "[";
+        size_t printed = 0;
+        for (const auto& chunk : c.chunks) {
+            for (const T& value : *chunk) {
+                os << value;
+                if (++printed < c.total) os << ", ";
+            }
+        }
+        os << "]";
+        return os;
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_SEGMENTED_CONTAINER_HPP
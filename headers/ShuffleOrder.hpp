@@ -0,0 +1,150 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_SHUFFLE_ORDER_HPP
+#define MYCONTAINERS_SHUFFLE_ORDER_HPP
+
+#include "Container.hpp"
+#include "Iterator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+
+namespace mycontainers {
+
+/**
+ * @brief An iterator that traverses the container in a pseudo-random order fixed by a seed.
+ *
+ * For example, if the container contains [7, 15, 6, 1, 2], seed 1 yields
+ * 6, 1, 2, 15, 7 and seed 2 yields 2, 15, 6, 1, 7; the same seed always
+ * yields the same order.
+ *
+ * The permutation is computed, not stored: position i maps to an element
+ * index through a 4-round Feistel network over the smallest even power of two
+ * that covers n, and results outside [0, n) are fed through the network again
+ * ("cycle walking") until they land inside. Since that domain is below 4n, a
+ * step costs at most a few rounds on average. Construction is O(1), the view
+ * needs O(1) memory and it is random-access. It is meant for sampling and load
+ * spreading, not for cryptography.
+ *
+ * Like Order, the view reads the container's storage directly: it must not
+ * outlive the container, and is invalidated by add() and remove().
+ *
+ * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container (see Container).
+ */
+template <typename T = int, size_t N = 0>
+class ShuffleOrder : public std::ranges::view_interface<ShuffleOrder<T, N>> {
+
+private:
+    static constexpr size_t rounds = 4;
+
+    const T* data = nullptr; ///< The container's elements
+    uint64_t length = 0;     ///< Number of elements
+    unsigned halfBits = 1;   ///< Bits per Feistel half; the domain is [0, 2^(2 * halfBits))
+    uint64_t keys[rounds] = {}; ///< Round keys derived from the seed
+
+    static uint64_t splitmix(uint64_t& state) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t feistel(uint64_t x) const {
+        const uint64_t mask = (uint64_t(1) << halfBits) - 1;
+        uint64_t left = x >> halfBits;
+        uint64_t right = x & mask;
+        for (size_t r = 0; r < rounds; ++r) {
+            uint64_t f = (right ^ keys[r]) * 0xff51afd7ed558ccdULL;
+            f ^= f >> 32;
+            uint64_t next = left ^ (f & mask);
+            left = right;
+            right = next;
+        }
+        return (left << halfBits) | right;
+    }
+
+    /** @brief Maps a position in [0, n) to the index of the element shown there. */
+    uint64_t permute(uint64_t i) const {
+        do {
+            i = feistel(i);
+        } while (i >= length);
+        return i;
+    }
+
+    /**
+     * @brief Random-access position in the shuffled sequence.
+     */
+    class Cursor {
+    private:
+        const ShuffleOrder* owner = nullptr;
+        size_t index = 0;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        Cursor() = default;
+        Cursor(const ShuffleOrder* o, size_t i) : owner(o), index(i) {}
+
+        reference operator*() const { return owner->data[owner->permute(index)]; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        Cursor& operator++() { ++index; return *this; }
+        Cursor operator++(int) { Cursor t = *this; ++index; return t; }
+        Cursor& operator--() { --index; return *this; }
+        Cursor operator--(int) { Cursor t = *this; --index; return t; }
+        Cursor& operator+=(difference_type n) { index += n; return *this; }
+        Cursor& operator-=(difference_type n) { index -= n; return *this; }
+
+        friend Cursor operator+(Cursor c, difference_type n) { return c += n; }
+        friend Cursor operator+(difference_type n, Cursor c) { return c += n; }
+        friend Cursor operator-(Cursor c, difference_type n) { return c -= n; }
+        friend difference_type operator-(const Cursor& a, const Cursor& b) {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+
+        bool operator==(const Cursor& other) const { return index == other.index; }
+        auto operator<=>(const Cursor& other) const { return index <=> other.index; }
+    };
+
+public:
+    using const_iterator = Iterator<Cursor>;
+
+    /**
+     * @brief Constructor that takes a reference to a container and a seed.
+     *
+     * @param c The container to traverse.
+     * @param seed Selects the permutation; equal seeds give equal orders.
+     */
+    ShuffleOrder(const Container<T, N>& c, uint64_t seed) : data(c.getData().data()), length(c.size()) {
+        while ((uint64_t(1) << (2 * halfBits)) < length) {
+            ++halfBits;
+        }
+        for (uint64_t& key : keys) {
+            key = splitmix(seed);
+        }
+    }
+
+    /**
+     * @brief Returns an iterator to the first element of the permutation.
+     */
+    const_iterator begin() const {
+        return const_iterator(Cursor(this, 0), Cursor(this, length));
+    }
+
+    /**
+     * @brief Returns an iterator past the last element of the permutation.
+     */
+    const_iterator end() const {
+        return const_iterator(Cursor(this, length), Cursor(this, length));
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_SHUFFLE_ORDER_HPP
@@ -5,8 +5,11 @@
 
 #include "Container.hpp"
 #include "Iterator.hpp"
+#include "AdaptiveSort.hpp"
+#include "ViewStorage.hpp"
 #include <vector>
 #include <algorithm>
+#include <ranges>
 #include <stdexcept>
 
 namespace mycontainers {
@@ -19,56 +22,67 @@ namespace mycontainers {
  * this iterator will yield: 1, 15, 2, 7, 6.
  *
  * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container and of the reordered copy.
  */
-template <typename T = int>
-class SideCrossOrder {
+template <typename T = int, size_t N = 0>
+class SideCrossOrder : public std::ranges::view_interface<SideCrossOrder<T, N>> {
 
 private:
-    std::vector<T> sideCrossData; ///< The container's data reordered in SideCross order.
+    detail::ViewStorage<typename Container<T, N>::storage_type, N == 0> sideCrossData; ///< The container's data reordered in SideCross order.
 
 public:
+    using const_iterator = Iterator<typename Container<T, N>::storage_type::const_iterator>;
+
     /**
      * @brief Constructor that takes a reference to a container and
      *        reorders its data in SideCross order.
      * 
      * @param c The container to iterate over.
      */
-    explicit SideCrossOrder(const Container<T>& c) {
+    explicit SideCrossOrder(const Container<T, N>& c) {
         const auto& data = c.getData();
-        std::vector<T> sorted = data;
-        std::sort(sorted.begin(), sorted.end());
+        typename Container<T, N>::storage_type sortedCopy;
+        if (!c.isSorted() && !c.hasSortedIndex()) {
+            sortedCopy = data;
+            adaptiveSort(sortedCopy.data(), sortedCopy.data() + sortedCopy.size());
+        }
+        // Read the container's storage directly when it is already in ascending order.
+        const typename Container<T, N>::storage_type& sorted = c.isSorted() ? data : c.hasSortedIndex() ? c.getSortedIndex() : sortedCopy;
 
         // Guard: do nothing if empty
         if (sorted.empty()) return;
 
         // Reorder: smallest, largest, second smallest, second largest, etc.
+        typename Container<T, N>::storage_type reordered;
+        reordered.reserve(sorted.size());
         size_t left = 0;
         size_t right = sorted.size() - 1;
         bool pickLeft = true;
         while (left <= right) {
             if (pickLeft) {
-                sideCrossData.push_back(sorted[left++]);
+                reordered.push_back(sorted[left++]);
             } else {
-                sideCrossData.push_back(sorted[right--]);
+                reordered.push_back(sorted[right--]);
             }
             pickLeft = !pickLeft;
         }
+        sideCrossData = detail::ViewStorage<typename Container<T, N>::storage_type, N == 0>(std::move(reordered));
     }
     
     /**
      * @brief Returns an iterator to the beginning of the SideCross-ordered container.
      */
-    Iterator<typename std::vector<T>::const_iterator> begin() const {
-        return Iterator<typename std::vector<T>::const_iterator>(
-            sideCrossData.begin(), sideCrossData.end());
+    const_iterator begin() const {
+        return const_iterator(
+            sideCrossData.get().begin(), sideCrossData.get().end());
     }
 
     /**
      * @brief Returns an iterator to the end of the SideCross-ordered container.
      */
-    Iterator<typename std::vector<T>::const_iterator> end() const {
-        return Iterator<typename std::vector<T>::const_iterator>(
-            sideCrossData.end(), sideCrossData.end());
+    const_iterator end() const {
+        return const_iterator(
+            sideCrossData.get().end(), sideCrossData.get().end());
     }
 };
 
@@ -0,0 +1,571 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_SIMD_KERNELS_HPP
+#define MYCONTAINERS_SIMD_KERNELS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MYCONTAINERS_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace mycontainers {
+namespace simd {
+
+/**
+ * @brief Instruction set levels the kernels can run at.
+ */
+enum class Isa { Scalar = 0, Avx2 = 1, Avx512 = 2 };
+
+/**
+ * @brief True for the element types that have explicit vector kernels (int, float, double).
+ */
+template <typename T>
+inline constexpr bool is_vectorizable_v =
+    std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+namespace detail {
+
+// ------------------ Scalar fallback ------------------
+
+template <typename T>
+size_t removeScalar(T* data, size_t n, T value) {
+    return std::remove(data, data + n, value) - data;
+}
+
+template <typename T>
+std::pair<T, T> minMaxScalar(const T* data, size_t n) {
+    auto [lo, hi] = std::minmax_element(data, data + n);
+    return {*lo, *hi};
+}
+
+template <typename T>
+size_t countScalar(const T* data, size_t n, T value) {
+    return std::count(data, data + n, value);
+}
+
+template <typename T>
+bool containsScalar(const T* data, size_t n, T value) {
+    return std::find(data, data + n, value) != data + n;
+}
+
+#ifdef MYCONTAINERS_SIMD_X86
+
+/**
+ * @brief Permutation table for AVX2 compaction: entry m lists the indices of the set
+ *        bits of the 8-bit lane mask m first, so a permute packs kept lanes to the front.
+ */
+inline constexpr std::array<std::array<std::uint32_t, 8>, 256> compactTable32 = [] {
+    std::array<std::array<std::uint32_t, 8>, 256> table{};
+    for (unsigned m = 0; m < 256; ++m) {
+        unsigned k = 0;
+        for (unsigned lane = 0; lane < 8; ++lane) {
+            if (m & (1u << lane)) table[m][k++] = lane;
+        }
+        while (k < 8) table[m][k++] = 0;
+    }
+    return table;
+}();
+
+/**
+ * @brief Same as compactTable32 for 4 x 64-bit lanes, expressed as pairs of 32-bit indices.
+ */
+inline constexpr std::array<std::array<std::uint32_t, 8>, 16> compactTable64 = [] {
+    std::array<std::array<std::uint32_t, 8>, 16> table{};
+    for (unsigned m = 0; m < 16; ++m) {
+        unsigned k = 0;
+        for (unsigned lane = 0; lane < 4; ++lane) {
+            if (m & (1u << lane)) {
+                table[m][k++] = 2 * lane;
+                table[m][k++] = 2 * lane + 1;
+            }
+        }
+        while (k < 8) table[m][k++] = 0;
+    }
+    return table;
+}();
+
+// ------------------ AVX2 kernels ------------------
+
+__attribute__((target("avx2,popcnt")))
+inline size_t removeAvx2(int* data, size_t n, int value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t out = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        unsigned keep = ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, needle))) & 0xFFu;
+        __m256i perm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compactTable32[keep].data()));
+        // out <= i, so the full-width store only touches the block that was just loaded.
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + out), _mm256_permutevar8x32_epi32(v, perm));
+        out += _mm_popcnt_u32(keep);
+    }
+    for (; i < n; ++i) {
+        if (data[i] != value) data[out++] = data[i];
+    }
+    return out;
+}
+
+__attribute__((target("avx2,popcnt")))
+inline size_t removeAvx2(float* data, size_t n, float value) {
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t out = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(data + i);
+        unsigned keep = ~_mm256_movemask_ps(_mm256_cmp_ps(v, needle, _CMP_EQ_OQ)) & 0xFFu;
+        __m256i perm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compactTable32[keep].data()));
+        _mm256_storeu_ps(data + out, _mm256_permutevar8x32_ps(v, perm));
+        out += _mm_popcnt_u32(keep);
+    }
+    for (; i < n; ++i) {
+        if (data[i] != value) data[out++] = data[i];
+    }
+    return out;
+}
+
+__attribute__((target("avx2,popcnt")))
+inline size_t removeAvx2(double* data, size_t n, double value) {
+    const __m256d needle = _mm256_set1_pd(value);
+    size_t out = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(data + i);
+        unsigned keep = ~_mm256_movemask_pd(_mm256_cmp_pd(v, needle, _CMP_EQ_OQ)) & 0xFu;
+        __m256i perm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compactTable64[keep].data()));
+        __m256 packed = _mm256_permutevar8x32_ps(_mm256_castpd_ps(v), perm);
+        _mm256_storeu_pd(data + out, _mm256_castps_pd(packed));
+        out += _mm_popcnt_u32(keep);
+    }
+    for (; i < n; ++i) {
+        if (data[i] != value) data[out++] = data[i];
+    }
+    return out;
+}
+
+__attribute__((target("avx2")))
+inline std::pair<int, int> minMaxAvx2(const int* data, size_t n) {
+    if (n < 8) return minMaxScalar(data, n);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    __m256i hi = lo;
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        lo = _mm256_min_epi32(lo, v);
+        hi = _mm256_max_epi32(hi, v);
+    }
+    alignas(32) int los[8], his[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(los), lo);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(his), hi);
+    int mn = *std::min_element(los, los + 8), mx = *std::max_element(his, his + 8);
+    for (; i < n; ++i) {
+        mn = std::min(mn, data[i]);
+        mx = std::max(mx, data[i]);
+    }
+    return {mn, mx};
+}
+
+__attribute__((target("avx2")))
+inline std::pair<float, float> minMaxAvx2(const float* data, size_t n) {
+    if (n < 8) return minMaxScalar(data, n);
+    __m256 lo = _mm256_loadu_ps(data);
+    __m256 hi = lo;
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(data + i);
+        lo = _mm256_min_ps(lo, v);
+        hi = _mm256_max_ps(hi, v);
+    }
+    alignas(32) float los[8], his[8];
+    _mm256_store_ps(los, lo);
+    _mm256_store_ps(his, hi);
+    float mn = *std::min_element(los, los + 8), mx = *std::max_element(his, his + 8);
+    for (; i < n; ++i) {
+        mn = std::min(mn, data[i]);
+        mx = std::max(mx, data[i]);
+    }
+    return {mn, mx};
+}
+
+__attribute__((target("avx2")))
+inline std::pair<double, double> minMaxAvx2(const double* data, size_t n) {
+    if (n < 4) return minMaxScalar(data, n);
+    __m256d lo = _mm256_loadu_pd(data);
+    __m256d hi = lo;
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(data + i);
+        lo = _mm256_min_pd(lo, v);
+        hi = _mm256_max_pd(hi, v);
+    }
+    alignas(32) double los[4], his[4];
+    _mm256_store_pd(los, lo);
+    _mm256_store_pd(his, hi);
+    double mn = *std::min_element(los, los + 4), mx = *std::max_element(his, his + 4);
+    for (; i < n; ++i) {
+        mn = std::min(mn, data[i]);
+        mx = std::max(mx, data[i]);
+    }
+    return {mn, mx};
+}
+
+__attribute__((target("avx2,popcnt")))
+inline size_t countAvx2(const int* data, size_t n, int value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t total = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        total += _mm_popcnt_u32(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, needle))));
+    }
+    return total + countScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2,popcnt")))
+inline size_t countAvx2(const float* data, size_t n, float value) {
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t total = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        total += _mm_popcnt_u32(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ)));
+    }
+    return total + countScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2,popcnt")))
+inline size_t countAvx2(const double* data, size_t n, double value) {
+    const __m256d needle = _mm256_set1_pd(value);
+    size_t total = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        total += _mm_popcnt_u32(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + i), needle, _CMP_EQ_OQ)));
+    }
+    return total + countScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+inline bool containsAvx2(const int* data, size_t n, int value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        if (!_mm256_testz_si256(_mm256_cmpeq_epi32(v, needle), _mm256_cmpeq_epi32(v, needle))) return true;
+    }
+    return containsScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+inline bool containsAvx2(const float* data, size_t n, float value) {
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ))) return true;
+    }
+    return containsScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+inline bool containsAvx2(const double* data, size_t n, double value) {
+    const __m256d needle = _mm256_set1_pd(value);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + i), needle, _CMP_EQ_OQ))) return true;
+    }
+    return containsScalar(data + i, n - i, value);
+}
+
+// ------------------ AVX-512 kernels ------------------
+
+// GCC's AVX-512 intrinsics start from _mm512_undefined_* values, which trips
+// -Wmaybe-uninitialized once they are inlined here.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+__attribute__((target("avx512f,popcnt")))
+inline size_t removeAvx512(int* data, size_t n, int value) {
+    const __m512i needle = _mm512_set1_epi32(value);
+    size_t out = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        __mmask16 keep = _mm512_cmpneq_epi32_mask(v, needle);
+        _mm512_mask_compressstoreu_epi32(data + out, keep, v);
+        out += _mm_popcnt_u32(keep);
+    }
+    for (; i < n; ++i) {
+        if (data[i] != value) data[out++] = data[i];
+    }
+    return out;
+}
+
+__attribute__((target("avx512f,popcnt")))
+inline size_t removeAvx512(float* data, size_t n, float value) {
+    const __m512 needle = _mm512_set1_ps(value);
+    size_t out = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 v = _mm512_loadu_ps(data + i);
+        __mmask16 keep = _mm512_cmp_ps_mask(v, needle, _CMP_NEQ_UQ);
+        _mm512_mask_compressstoreu_ps(data + out, keep, v);
+        out += _mm_popcnt_u32(keep);
+    }
+    for (; i < n; ++i) {
+        if (data[i] != value) data[out++] = data[i];
+    }
+    return out;
+}
+
+__attribute__((target("avx512f,popcnt")))
+inline size_t removeAvx512(double* data, size_t n, double value) {
+    const __m512d needle = _mm512_set1_pd(value);
+    size_t out = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_loadu_pd(data + i);
+        __mmask8 keep = _mm512_cmp_pd_mask(v, needle, _CMP_NEQ_UQ);
+        _mm512_mask_compressstoreu_pd(data + out, keep, v);
+        out += _mm_popcnt_u32(keep);
+    }
+    for (; i < n; ++i) {
+        if (data[i] != value) data[out++] = data[i];
+    }
+    return out;
+}
+
+__attribute__((target("avx512f")))
+inline std::pair<int, int> minMaxAvx512(const int* data, size_t n) {
+    if (n < 16) return minMaxScalar(data, n);
+    __m512i lo = _mm512_loadu_si512(data);
+    __m512i hi = lo;
+    size_t i = 16;
+    for (; i + 16 <= n; i += 16) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        lo = _mm512_min_epi32(lo, v);
+        hi = _mm512_max_epi32(hi, v);
+    }
+    int mn = _mm512_reduce_min_epi32(lo), mx = _mm512_reduce_max_epi32(hi);
+    for (; i < n; ++i) {
+        mn = std::min(mn, data[i]);
+        mx = std::max(mx, data[i]);
+    }
+    return {mn, mx};
+}
+
+__attribute__((target("avx512f")))
+inline std::pair<float, float> minMaxAvx512(const float* data, size_t n) {
+    if (n < 16) return minMaxScalar(data, n);
+    __m512 lo = _mm512_loadu_ps(data);
+    __m512 hi = lo;
+    size_t i = 16;
+    for (; i + 16 <= n; i += 16) {
+        __m512 v = _mm512_loadu_ps(data + i);
+        lo = _mm512_min_ps(lo, v);
+        hi = _mm512_max_ps(hi, v);
+    }
+    float mn = _mm512_reduce_min_ps(lo), mx = _mm512_reduce_max_ps(hi);
+    for (; i < n; ++i) {
+        mn = std::min(mn, data[i]);
+        mx = std::max(mx, data[i]);
+    }
+    return {mn, mx};
+}
+
+__attribute__((target("avx512f")))
+inline std::pair<double, double> minMaxAvx512(const double* data, size_t n) {
+    if (n < 8) return minMaxScalar(data, n);
+    __m512d lo = _mm512_loadu_pd(data);
+    __m512d hi = lo;
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_loadu_pd(data + i);
+        lo = _mm512_min_pd(lo, v);
+        hi = _mm512_max_pd(hi, v);
+    }
+    double mn = _mm512_reduce_min_pd(lo), mx = _mm512_reduce_max_pd(hi);
+    for (; i < n; ++i) {
+        mn = std::min(mn, data[i]);
+        mx = std::max(mx, data[i]);
+    }
+    return {mn, mx};
+}
+
+__attribute__((target("avx512f,popcnt")))
+inline size_t countAvx512(const int* data, size_t n, int value) {
+    const __m512i needle = _mm512_set1_epi32(value);
+    size_t total = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        total += _mm_popcnt_u32(_mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i), needle));
+    }
+    return total + countScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx512f,popcnt")))
+inline size_t countAvx512(const float* data, size_t n, float value) {
+    const __m512 needle = _mm512_set1_ps(value);
+    size_t total = 0, i = 0;
+    for (; i + 16 <= n; i += 16) {
+        total += _mm_popcnt_u32(_mm512_cmp_ps_mask(_mm512_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+    }
+    return total + countScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx512f,popcnt")))
+inline size_t countAvx512(const double* data, size_t n, double value) {
+    const __m512d needle = _mm512_set1_pd(value);
+    size_t total = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        total += _mm_popcnt_u32(_mm512_cmp_pd_mask(_mm512_loadu_pd(data + i), needle, _CMP_EQ_OQ));
+    }
+    return total + countScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx512f")))
+inline bool containsAvx512(const int* data, size_t n, int value) {
+    const __m512i needle = _mm512_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        if (_mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i), needle)) return true;
+    }
+    return containsScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx512f")))
+inline bool containsAvx512(const float* data, size_t n, float value) {
+    const __m512 needle = _mm512_set1_ps(value);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        if (_mm512_cmp_ps_mask(_mm512_loadu_ps(data + i), needle, _CMP_EQ_OQ)) return true;
+    }
+    return containsScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx512f")))
+inline bool containsAvx512(const double* data, size_t n, double value) {
+    const __m512d needle = _mm512_set1_pd(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        if (_mm512_cmp_pd_mask(_mm512_loadu_pd(data + i), needle, _CMP_EQ_OQ)) return true;
+    }
+    return containsScalar(data + i, n - i, value);
+}
+
+#pragma GCC diagnostic pop
+
+#endif // MYCONTAINERS_SIMD_X86
+
+/** @brief Best instruction set supported by the running CPU. */
+inline Isa detectIsa() {
+#ifdef MYCONTAINERS_SIMD_X86
+    static const Isa detected = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return Isa::Avx512;
+        if (__builtin_cpu_supports("avx2")) return Isa::Avx2;
+        return Isa::Scalar;
+    }();
+    return detected;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+/** @brief Storage for the currently selected instruction set. */
+inline Isa& isaSlot() {
+    static Isa current = detectIsa();
+    return current;
+}
+
+} // namespace detail
+
+/**
+ * @brief Returns the instruction set the kernels currently dispatch to.
+ */
+inline Isa activeIsa() {
+    return detail::isaSlot();
+}
+
+/**
+ * @brief Restricts dispatch to at most the given instruction set (clamped to what the CPU supports).
+ *
+ * Intended for tests and benchmarks that compare the vector paths against the scalar one.
+ *
+ * @return Isa The instruction set actually selected.
+ */
+inline Isa setIsa(Isa requested) {
+    Isa best = detail::detectIsa();
+    detail::isaSlot() = static_cast<int>(requested) < static_cast<int>(best) ? requested : best;
+    return detail::isaSlot();
+}
+
+/**
+ * @brief Removes every element equal to value from [data, data + n), keeping the order of the rest.
+ *
+ * @return size_t The number of elements kept (the new logical size).
+ */
+template <typename T>
+size_t removeValue(T* data, size_t n, const T& value) {
+#ifdef MYCONTAINERS_SIMD_X86
+    if constexpr (is_vectorizable_v<T>) {
+        switch (activeIsa()) {
+            case Isa::Avx512: return detail::removeAvx512(data, n, value);
+            case Isa::Avx2:   return detail::removeAvx2(data, n, value);
+            case Isa::Scalar: break;
+        }
+    }
+#endif
+    return detail::removeScalar(data, n, value);
+}
+
+/**
+ * @brief Returns the smallest and largest element of a non-empty range.
+ *
+ * Extrema of ranges that contain NaN are unspecified.
+ */
+template <typename T>
+std::pair<T, T> minMax(const T* data, size_t n) {
+#ifdef MYCONTAINERS_SIMD_X86
+    if constexpr (is_vectorizable_v<T>) {
+        switch (activeIsa()) {
+            case Isa::Avx512: return detail::minMaxAvx512(data, n);
+            case Isa::Avx2:   return detail::minMaxAvx2(data, n);
+            case Isa::Scalar: break;
+        }
+    }
+#endif
+    return detail::minMaxScalar(data, n);
+}
+
+/**
+ * @brief Counts the elements of [data, data + n) equal to value.
+ */
+template <typename T>
+size_t count(const T* data, size_t n, const T& value) {
+#ifdef MYCONTAINERS_SIMD_X86
+    if constexpr (is_vectorizable_v<T>) {
+        switch (activeIsa()) {
+            case Isa::Avx512: return detail::countAvx512(data, n, value);
+            case Isa::Avx2:   return detail::countAvx2(data, n, value);
+            case Isa::Scalar: break;
+        }
+    }
+#endif
+    return detail::countScalar(data, n, value);
+}
+
+/**
+ * @brief Returns true if any element of [data, data + n) equals value, stopping at the first hit.
+ */
+template <typename T>
+bool contains(const T* data, size_t n, const T& value) {
+#ifdef MYCONTAINERS_SIMD_X86
+    if constexpr (is_vectorizable_v<T>) {
+        switch (activeIsa()) {
+            case Isa::Avx512: return detail::containsAvx512(data, n, value);
+            case Isa::Avx2:   return detail::containsAvx2(data, n, value);
+            case Isa::Scalar: break;
+        }
+    }
+#endif
+    return detail::containsScalar(data, n, value);
+}
+
+} // namespace simd
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_SIMD_KERNELS_HPP
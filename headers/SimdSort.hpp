@@ -0,0 +1,289 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_SIMD_SORT_HPP
+#define MYCONTAINERS_SIMD_SORT_HPP
+
+#include "SimdKernels.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace mycontainers {
+namespace simd {
+
+/**
+ * @brief True for the element types that have a vectorized sort (32-bit int and float).
+ */
+template <typename T>
+inline constexpr bool is_sortable_v = std::is_same_v<T, int> || std::is_same_v<T, float>;
+
+namespace detail {
+
+constexpr size_t networkSize = 16; ///< Ranges up to this size are finished by the sorting network
+constexpr size_t cachedSpillElements = size_t(1) << 16; ///< Largest scratch buffer sort() keeps per thread between calls
+
+template <typename T>
+T medianOfThree(T a, T b, T c) {
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+#ifdef MYCONTAINERS_SIMD_X86
+
+/**
+ * @brief Lane masks for the in-register stages of a 16-element bitonic network held in
+ *        two 8-lane registers. Entry [stage][reg] has -1 in the lanes that keep the larger
+ *        value of their compare-exchange pair, 0 in the lanes that keep the smaller one.
+ */
+struct BitonicStages {
+    int k[9];
+    int j[9];
+    std::int32_t takeMax[9][2][8];
+};
+
+inline constexpr BitonicStages bitonicStages = [] {
+    BitonicStages st{};
+    int s = 0;
+    for (int k = 2; k <= 16; k <<= 1) {
+        for (int j = k >> 1; j > 0; j >>= 1) {
+            if (j == 8) continue; // crosses the two registers, handled separately
+            st.k[s] = k;
+            st.j[s] = j;
+            for (int reg = 0; reg < 2; ++reg) {
+                for (int lane = 0; lane < 8; ++lane) {
+                    int global = reg * 8 + lane;
+                    bool ascending = (global & k) == 0;
+                    bool lowerOfPair = lane < (lane ^ j);
+                    st.takeMax[s][reg][lane] = (ascending != lowerOfPair) ? -1 : 0;
+                }
+            }
+            ++s;
+        }
+    }
+    return st;
+}();
+
+/** @brief AVX2 primitives used by the generic network and quicksort, for 32-bit int. */
+struct Avx2Int {
+    using vec = __m256i;
+    __attribute__((target("avx2"))) static vec load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    __attribute__((target("avx2"))) static void store(int* p, vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    __attribute__((target("avx2"))) static vec min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+    __attribute__((target("avx2"))) static vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+    __attribute__((target("avx2"))) static vec permute(vec v, __m256i idx) { return _mm256_permutevar8x32_epi32(v, idx); }
+    __attribute__((target("avx2"))) static vec blend(vec a, vec b, __m256i mask) { return _mm256_blendv_epi8(a, b, mask); }
+    __attribute__((target("avx2"))) static __m256i less(vec a, vec b) { return _mm256_cmpgt_epi32(b, a); }
+};
+
+/** @brief AVX2 primitives used by the generic network and quicksort, for float. */
+struct Avx2Float {
+    using vec = __m256;
+    __attribute__((target("avx2"))) static vec load(const float* p) { return _mm256_loadu_ps(p); }
+    __attribute__((target("avx2"))) static void store(float* p, vec v) { _mm256_storeu_ps(p, v); }
+    __attribute__((target("avx2"))) static vec min(vec a, vec b) { return _mm256_min_ps(a, b); }
+    __attribute__((target("avx2"))) static vec max(vec a, vec b) { return _mm256_max_ps(a, b); }
+    __attribute__((target("avx2"))) static vec permute(vec v, __m256i idx) { return _mm256_permutevar8x32_ps(v, idx); }
+    __attribute__((target("avx2"))) static vec blend(vec a, vec b, __m256i mask) { return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(mask)); }
+    __attribute__((target("avx2"))) static __m256i less(vec a, vec b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+};
+
+template <typename T>
+using Avx2Ops = std::conditional_t<std::is_same_v<T, int>, Avx2Int, Avx2Float>;
+
+/**
+ * @brief Sorts up to 16 elements with a bitonic network kept in two AVX2 registers.
+ *
+ * The input is padded with the largest representable value so the network always
+ * runs at full width; each stage is one permute, min, max and blend per register.
+ */
+template <typename T>
+__attribute__((target("avx2")))
+void bitonicNetwork(T* a, size_t n) {
+    using Ops = Avx2Ops<T>;
+    constexpr T pad = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                           : std::numeric_limits<T>::max();
+    T buf[networkSize];
+    for (size_t i = 0; i < networkSize; ++i) {
+        buf[i] = i < n ? a[i] : pad;
+    }
+    typename Ops::vec r[2] = {Ops::load(buf), Ops::load(buf + 8)};
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    for (int s = 0; s < 9; ++s) {
+        if (bitonicStages.k[s] == 16 && bitonicStages.j[s] == 4) {
+            // The (k = 16, j = 8) stage pairs lane i of one register with lane i of the other.
+            // Swap by one compare rather than min/max: on ties (-0.0 and +0.0) min and max
+            // both return their second operand, which would duplicate it and lose the other.
+            __m256i swap = Ops::less(r[1], r[0]);
+            typename Ops::vec lo = Ops::blend(r[0], r[1], swap);
+            r[1] = Ops::blend(r[1], r[0], swap);
+            r[0] = lo;
+        }
+        __m256i partner = _mm256_xor_si256(lanes, _mm256_set1_epi32(bitonicStages.j[s]));
+        for (int reg = 0; reg < 2; ++reg) {
+            typename Ops::vec other = Ops::permute(r[reg], partner);
+            __m256i takeMax = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bitonicStages.takeMax[s][reg]));
+            r[reg] = Ops::blend(Ops::min(r[reg], other), Ops::max(r[reg], other), takeMax);
+        }
+    }
+    Ops::store(buf, r[0]);
+    Ops::store(buf + 8, r[1]);
+    std::copy(buf, buf + n, a);
+}
+
+/**
+ * @brief Stable AVX2 partition of [a, a + n) around pivot.
+ *
+ * Elements that go left (x < pivot, or x <= pivot when orEqual is set) are
+ * compacted in place; the others are compacted into spill and copied back after them.
+ *
+ * @param spill Scratch space of at least n + 8 elements.
+ * @return size_t The number of elements that went left.
+ */
+__attribute__((target("avx2,popcnt")))
+inline size_t partitionAvx2(int* a, size_t n, int pivot, bool orEqual, int* spill) {
+    const __m256i p = _mm256_set1_epi32(pivot);
+    size_t left = 0, right = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        unsigned goLeft = orEqual
+            ? ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, p))) & 0xFFu
+            : _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(p, v)));
+        unsigned goRight = ~goLeft & 0xFFu;
+        __m256i permLeft = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compactTable32[goLeft].data()));
+        __m256i permRight = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compactTable32[goRight].data()));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + left), _mm256_permutevar8x32_epi32(v, permLeft));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(spill + right), _mm256_permutevar8x32_epi32(v, permRight));
+        left += _mm_popcnt_u32(goLeft);
+        right += _mm_popcnt_u32(goRight);
+    }
+    for (; i < n; ++i) {
+        if (orEqual ? !(pivot < a[i]) : a[i] < pivot) a[left++] = a[i];
+        else spill[right++] = a[i];
+    }
+    std::copy(spill, spill + right, a + left);
+    return left;
+}
+
+/** @copydoc partitionAvx2(int*, size_t, int, bool, int*) */
+__attribute__((target("avx2,popcnt")))
+inline size_t partitionAvx2(float* a, size_t n, float pivot, bool orEqual, float* spill) {
+    const __m256 p = _mm256_set1_ps(pivot);
+    size_t left = 0, right = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(a + i);
+        unsigned goLeft = orEqual ? _mm256_movemask_ps(_mm256_cmp_ps(v, p, _CMP_LE_OQ))
+                                  : _mm256_movemask_ps(_mm256_cmp_ps(v, p, _CMP_LT_OQ));
+        unsigned goRight = ~goLeft & 0xFFu;
+        __m256i permLeft = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compactTable32[goLeft].data()));
+        __m256i permRight = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(compactTable32[goRight].data()));
+        _mm256_storeu_ps(a + left, _mm256_permutevar8x32_ps(v, permLeft));
+        _mm256_storeu_ps(spill + right, _mm256_permutevar8x32_ps(v, permRight));
+        left += _mm_popcnt_u32(goLeft);
+        right += _mm_popcnt_u32(goRight);
+    }
+    for (; i < n; ++i) {
+        if (orEqual ? !(pivot < a[i]) : a[i] < pivot) a[left++] = a[i];
+        else spill[right++] = a[i];
+    }
+    std::copy(spill, spill + right, a + left);
+    return left;
+}
+
+/**
+ * @brief Quicksort with AVX2 partitioning and a bitonic network for the base case.
+ *
+ * Recurses into the smaller side and loops on the larger one; falls back to
+ * std::sort once depth is exhausted so adversarial inputs stay O(n log n).
+ */
+template <typename T>
+void quicksortAvx2(T* a, size_t n, T* spill, int depth) {
+    while (n > networkSize) {
+        if (depth-- == 0) {
+            std::sort(a, a + n);
+            return;
+        }
+        T pivot = medianOfThree(a[0], a[n / 2], a[n - 1]);
+        size_t k = partitionAvx2(a, n, pivot, false, spill);
+        if (k == 0) {
+            // The pivot is the minimum: peel off every element equal to it.
+            k = partitionAvx2(a, n, pivot, true, spill);
+            a += k;
+            n -= k;
+            continue;
+        }
+        if (k < n - k) {
+            quicksortAvx2(a, k, spill, depth);
+            a += k;
+            n -= k;
+        } else {
+            quicksortAvx2(a + k, n - k, spill, depth);
+            n = k;
+        }
+    }
+    bitonicNetwork(a, n);
+}
+
+#endif // MYCONTAINERS_SIMD_X86
+
+} // namespace detail
+
+/**
+ * @brief Sorts [first, last) in ascending order.
+ *
+ * For int and float on AVX2-capable CPUs this runs a vectorized quicksort;
+ * every other type, CPU, or a float range containing NaN uses std::sort.
+ * The result holds the same values in the same order std::sort produces; only the
+ * relative order of -0.0 and +0.0, which std::sort leaves unspecified as well, may differ.
+ */
+template <typename T>
+void sort(T* first, T* last) {
+#ifdef MYCONTAINERS_SIMD_X86
+    if constexpr (is_sortable_v<T>) {
+        size_t n = last - first;
+        if (activeIsa() != Isa::Scalar && n > detail::networkSize) {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (std::any_of(first, last, [](T x) { return x != x; })) {
+                    std::sort(first, last);
+                    return;
+                }
+            }
+            int depth = 0;
+            for (size_t m = n; m > 1; m >>= 1) depth += 2;
+            if (n + 8 <= detail::cachedSpillElements) {
+                // Reused across calls so per-request sorts of a few thousand elements do not allocate.
+                thread_local std::vector<T> spill;
+                if (spill.size() < n + 8) {
+                    spill.resize(n + 8);
+                }
+                detail::quicksortAvx2(first, n, spill.data(), depth);
+            } else {
+                // Large sorts pay one allocation, which they amortize, and give the memory back.
+                std::vector<T> spill(n + 8);
+                detail::quicksortAvx2(first, n, spill.data(), depth);
+            }
+            return;
+        }
+    }
+#endif
+    std::sort(first, last);
+}
+
+/**
+ * @brief Sorts [first, last) in descending order, using the vectorized path where sort() would.
+ */
+template <typename T>
+void sortDescending(T* first, T* last) {
+    if constexpr (is_sortable_v<T>) {
+        sort(first, last);
+        std::reverse(first, last);
+    } else {
+        std::sort(first, last, std::greater<T>());
+    }
+}
+
+} // namespace simd
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_SIMD_SORT_HPP
@@ -0,0 +1,281 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_SMALL_VECTOR_HPP
+#define MYCONTAINERS_SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * @brief A vector with room for N elements inside the object itself.
+ *
+ * Up to N elements live in an inline buffer, so a SmallVector declared on the
+ * stack (or as a member of a stack object) never touches the heap. Growing past
+ * N moves the elements to a heap buffer, after which it behaves like std::vector.
+ * Iterators are plain pointers; like std::vector, they are invalidated by growth.
+ *
+ * @tparam T The type of the elements.
+ * @tparam N Number of elements stored inline.
+ */
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs an inline capacity; use std::vector for N == 0.");
+
+private:
+    alignas(T) unsigned char inlineBuffer[N * sizeof(T)]; ///< Storage for the first N elements
+    T* first = reinterpret_cast<T*>(inlineBuffer); ///< Current storage: inlineBuffer or a heap buffer
+    size_t count = 0; ///< Number of constructed elements
+    size_t cap = N;   ///< Capacity of the current storage
+
+    T* inlineData() { return reinterpret_cast<T*>(inlineBuffer); }
+
+    /**
+     * @brief Moves the elements into a buffer of the given capacity (inline if it fits).
+     *
+     * Like std::vector, elements are copied instead when their move may throw
+     * and they are copyable, so a throwing relocation leaves the vector as it
+     * was; a newly allocated buffer is freed again.
+     */
+    void relocate(size_t newCap) {
+        T* target = newCap <= N ? inlineData() : std::allocator<T>().allocate(newCap);
+        if (target == first) {
+            return;
+        }
+        try {
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+                std::uninitialized_move(first, first + count, target);
+            } else {
+                std::uninitialized_copy(first, first + count, target);
+            }
+        } catch (...) {
+            if (target != inlineData()) {
+                std::allocator<T>().deallocate(target, newCap);
+            }
+            throw;
+        }
+        std::destroy(first, first + count);
+        releaseHeap();
+        first = target;
+        cap = std::max(newCap, N);
+    }
+
+    void releaseHeap() {
+        if (isHeap()) {
+            std::allocator<T>().deallocate(first, cap);
+        }
+    }
+
+    void grow(size_t needed) {
+        if (needed > cap) {
+            relocate(std::max(needed, cap * 2));
+        }
+    }
+
+public:
+    using value_type             = T;
+    using size_type              = size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using iterator               = T*;
+    using const_iterator         = const T*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /** @brief Default constructor. Initializes an empty vector using the inline buffer. */
+    SmallVector() = default;
+
+    /** @brief Constructs from the elements of [from, to). */
+    template <std::input_iterator It>
+    SmallVector(It from, It to) {
+        try {
+            for (; from != to; ++from) {
+                push_back(*from);
+            }
+        } catch (...) {
+            // The destructor does not run for a throwing constructor.
+            clear();
+            releaseHeap();
+            throw;
+        }
+    }
+
+    /** @brief Copy constructor. */
+    SmallVector(const SmallVector& other) {
+        grow(other.count);
+        try {
+            std::uninitialized_copy(other.first, other.first + other.count, first);
+        } catch (...) {
+            releaseHeap(); // uninitialized_copy already destroyed what it built
+            throw;
+        }
+        count = other.count;
+    }
+
+    /** @brief Move constructor. Steals a heap buffer; inline elements are moved one by one. */
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.isHeap()) {
+            first = std::exchange(other.first, other.inlineData());
+            cap = std::exchange(other.cap, N);
+            count = std::exchange(other.count, 0);
+        } else {
+            std::uninitialized_move(other.first, other.first + other.count, first);
+            count = other.count;
+            other.clear();
+        }
+    }
+
+    /** @brief Copy assignment operator. */
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            SmallVector copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    /** @brief Move assignment operator. */
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            if (other.isHeap()) {
+                releaseHeap();
+                first = std::exchange(other.first, other.inlineData());
+                cap = std::exchange(other.cap, N);
+                count = std::exchange(other.count, 0);
+            } else {
+                // other holds at most N elements, which always fit in the current storage.
+                std::uninitialized_move(other.first, other.first + other.count, first);
+                count = other.count;
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    /** @brief Destructor. Destroys the elements and frees a heap buffer, if any. */
+    ~SmallVector() {
+        clear();
+        releaseHeap();
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return cap; }
+    bool empty() const { return count == 0; }
+
+    /** @brief Returns true once the elements have spilled from the inline buffer to the heap. */
+    bool isHeap() const { return first != reinterpret_cast<const T*>(inlineBuffer); }
+
+    T* data() { return first; }
+    const T* data() const { return first; }
+
+    T& operator[](size_t i) { return first[i]; }
+    const T& operator[](size_t i) const { return first[i]; }
+
+    T& front() { return first[0]; }
+    const T& front() const { return first[0]; }
+    T& back() { return first[count - 1]; }
+    const T& back() const { return first[count - 1]; }
+
+    iterator begin() { return first; }
+    iterator end() { return first + count; }
+    const_iterator begin() const { return first; }
+    const_iterator end() const { return first + count; }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    /** @brief Ensures room for at least n elements. */
+    void reserve(size_t n) {
+        grow(n);
+    }
+
+    /** @brief Moves the elements back into the inline buffer when they fit, or trims the heap buffer. */
+    void shrink_to_fit() {
+        if (isHeap() && count < cap) {
+            relocate(count);
+        }
+    }
+
+    void push_back(const T& value) {
+        if (count == cap) {
+            T copy = value; // value may refer to an element that growth is about to move
+            grow(count + 1);
+            new (first + count) T(std::move(copy));
+        } else {
+            new (first + count) T(value);
+        }
+        ++count;
+    }
+
+    void pop_back() {
+        std::destroy_at(first + --count);
+    }
+
+    /** @brief Resizes to n elements, value-initializing new ones. */
+    void resize(size_t n) {
+        if (n < count) {
+            std::destroy(first + n, first + count);
+        } else {
+            grow(n);
+            std::uninitialized_value_construct(first + count, first + n);
+        }
+        count = n;
+    }
+
+    void clear() {
+        std::destroy(first, first + count);
+        count = 0;
+    }
+
+    /**
+     * @brief Inserts value before pos.
+     *
+     * @return iterator Position of the inserted element.
+     */
+    iterator insert(const_iterator pos, const T& value) {
+        size_t offset = pos - first;
+        push_back(value);
+        std::rotate(first + offset, first + count - 1, first + count);
+        return first + offset;
+    }
+
+    /**
+     * @brief Erases [from, to), shifting the following elements forward.
+     *
+     * @return iterator Position following the last erased element.
+     */
+    iterator erase(const_iterator from, const_iterator to) {
+        T* target = first + (from - first);
+        T* source = first + (to - first);
+        T* newEnd = std::move(source, first + count, target);
+        std::destroy(newEnd, first + count);
+        count = newEnd - first;
+        return target;
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    friend bool operator==(const SmallVector& a, const SmallVector& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    friend bool operator==(const SmallVector& a, const std::vector<T>& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_SMALL_VECTOR_HPP
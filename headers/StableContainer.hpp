@@ -0,0 +1,514 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_STABLE_CONTAINER_HPP
+#define MYCONTAINERS_STABLE_CONTAINER_HPP
+
+#include "Container.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * @brief Identifies one element of a StableContainer.
+ *
+ * The generation distinguishes the element from later ones that reuse the same
+ * slot, so a handle to an erased element is detected instead of silently
+ * referring to a different one.
+ */
+struct Handle {
+    uint32_t slot = 0;       ///< Index into the container's slot table
+    uint32_t generation = 0; ///< Generation of the slot when the handle was issued
+
+    bool operator==(const Handle& other) const = default;
+};
+
+/**
+ * @brief A container whose elements can be erased individually, in O(1), through handles.
+ *
+ * add() returns a Handle. erase(handle) only marks the element's position as a
+ * tombstone in a bitmap; the dead positions are compacted away in one O(n) pass
+ * once they exceed a fraction of the storage (see setMaxDeadRatio()), or on
+ * compact(). A slot table maps every handle to the element's current position,
+ * so handles stay valid across compaction.
+ *
+ * remove(value) defers in the same way: it tombstones every occurrence instead of
+ * shifting the tail of the storage on each call.
+ *
+ * Reading never compacts: live() walks the storage and skips tombstones through
+ * the bitmap, and the order views (s | ascending, ...) are built on snapshot(),
+ * a Container of the live elements. With startBackgroundCompaction(), a worker
+ * thread compacts whenever the dead ratio is crossed and every public method
+ * takes a lock; live() and the views stay usable, since both hold their own
+ * copy-on-write share of the storage.
+ *
+ * @tparam T The type of elements stored in the container.
+ */
+template <typename T = int>
+class StableContainer {
+
+private:
+    /** @brief Where the element of a slot currently lives. */
+    struct Slot {
+        size_t position = 0;
+        uint32_t generation = 0;
+        bool occupied = false;
+    };
+
+    Container<T> dense;                ///< Live and tombstoned elements, in insertion order
+    std::vector<bool> dead;            ///< Tombstone bitmap, parallel to dense
+    std::vector<uint32_t> slotOf;      ///< Slot owning each position of dense
+    std::vector<Slot> slots;           ///< Slot table, indexed by Handle::slot
+    std::vector<uint32_t> freeSlots;   ///< Slots released by erase(), reused by add()
+    size_t deadCount = 0;              ///< Number of tombstones in dense
+    double maxDeadRatio = 0.5;         ///< Fraction of tombstones that triggers compaction
+
+    /** @brief State of the background compaction thread. */
+    struct Compactor {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable caughtUp; ///< Notified after every background pass
+        bool stopping = false;
+        std::thread thread;
+    };
+    std::unique_ptr<Compactor> compactor; ///< Present while background compaction runs
+
+    /** @brief Locks the container if a background compactor may touch it concurrently. */
+    std::unique_lock<std::mutex> lock() const {
+        return compactor ? std::unique_lock<std::mutex>(compactor->mutex) : std::unique_lock<std::mutex>();
+    }
+
+    bool overThreshold() const {
+        return static_cast<double>(deadCount) > maxDeadRatio * static_cast<double>(dense.size());
+    }
+
+    /** @brief Releases the slot of the element at position, turning the element into a tombstone. */
+    void kill(size_t position) {
+        Slot& slot = slots[slotOf[position]];
+        slot.occupied = false;
+        ++slot.generation;
+        freeSlots.push_back(slotOf[position]);
+        dead[position] = true;
+        ++deadCount;
+    }
+
+    /** @brief Compacts inline, or wakes the background compactor, once the dead ratio is crossed. */
+    void afterRemoval() {
+        if (!overThreshold()) {
+            return;
+        }
+        if (compactor) {
+            compactor->wake.notify_one();
+        } else {
+            compactLocked();
+        }
+    }
+
+    void compactLocked() {
+        if (deadCount == 0) {
+            return;
+        }
+        size_t out = 0;
+        for (size_t i = 0; i < slotOf.size(); ++i) {
+            if (!dead[i]) {
+                slotOf[out] = slotOf[i];
+                slots[slotOf[out]].position = out;
+                ++out;
+            }
+        }
+        slotOf.resize(out);
+        dense.removeMarked(dead);
+        dead.assign(out, false);
+        deadCount = 0;
+    }
+
+    /**
+     * @brief Returns the slot of a handle.
+     *
+     * @throws std::out_of_range if the handle was erased or never issued by this container.
+     */
+    const Slot& resolve(Handle h) const {
+        if (h.slot >= slots.size() || !slots[h.slot].occupied || slots[h.slot].generation != h.generation) {
+            throw std::out_of_range("Invalid or erased handle.");
+        }
+        return slots[h.slot];
+    }
+
+public:
+    /**
+     * @brief Forward view over the live elements, in insertion order, that skips tombstones.
+     *
+     * Built by live() without compacting: it shares the storage copy-on-write
+     * and copies only the tombstone bitmap, so later changes to the container,
+     * a background compaction included, never affect it. Copies of the view
+     * share that state.
+     */
+    class LiveView : public std::ranges::view_interface<LiveView> {
+
+    private:
+        /** @brief The storage and bitmap as of live(). */
+        struct Frozen {
+            Container<T> elements;
+            std::vector<bool> dead;
+            size_t live = 0;
+        };
+        std::shared_ptr<const Frozen> frozen;
+
+    public:
+        /**
+         * @brief Iterator that steps over the positions marked in the bitmap.
+         */
+        class const_iterator {
+        private:
+            const T* data = nullptr;
+            const std::vector<bool>* dead = nullptr;
+            size_t index = 0;
+            size_t last = 0;
+
+            void skipDead() {
+                while (index < last && (*dead)[index]) {
+                    ++index;
+                }
+            }
+
+        public:
+            using iterator_concept  = std::forward_iterator_tag;
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = T;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const T*;
+            using reference         = const T&;
+
+            const_iterator() = default;
+            const_iterator(const T* d, const std::vector<bool>* m, size_t i, size_t n)
+                : data(d), dead(m), index(i), last(n) {
+                skipDead();
+            }
+
+            reference operator*() const {
+                if (index == last) throw std::out_of_range("Cannot dereference end iterator.");
+                return data[index];
+            }
+
+            pointer operator->() const {
+                return &**this;
+            }
+
+            const_iterator& operator++() {
+                ++index;
+                skipDead();
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            bool operator==(const const_iterator& other) const { return index == other.index; }
+        };
+
+        LiveView(const Container<T>& elements, const std::vector<bool>& dead, size_t live)
+            : frozen(std::make_shared<const Frozen>(Frozen{elements, dead, live})) {}
+
+        /** @brief Returns an iterator to the first live element. */
+        const_iterator begin() const {
+            const auto& data = frozen->elements.getData();
+            return const_iterator(data.data(), &frozen->dead, 0, data.size());
+        }
+
+        /** @brief Returns an iterator past the last element. */
+        const_iterator end() const {
+            const auto& data = frozen->elements.getData();
+            return const_iterator(data.data(), &frozen->dead, data.size(), data.size());
+        }
+
+        /** @brief Returns the number of live elements. */
+        size_t size() const {
+            return frozen->live;
+        }
+    };
+
+    /** @brief Default constructor. Initializes an empty container. */
+    StableContainer() = default;
+
+    /**
+     * @brief Copy constructor. Copies the elements, handles and tombstones; the
+     *        copy does not run a background compactor.
+     *
+     * @param other The container to copy from.
+     */
+    StableContainer(const StableContainer& other) {
+        auto guard = other.lock();
+        dense = other.dense;
+        dead = other.dead;
+        slotOf = other.slotOf;
+        slots = other.slots;
+        freeSlots = other.freeSlots;
+        deadCount = other.deadCount;
+        maxDeadRatio = other.maxDeadRatio;
+    }
+
+    /**
+     * @brief Copy assignment operator. Keeps this container's background compactor, if any.
+     *
+     * @param other The container to assign from.
+     * @return StableContainer& Reference to this container.
+     */
+    StableContainer& operator=(const StableContainer& other) {
+        if (this != &other) {
+            StableContainer copy(other);
+            auto guard = lock();
+            dense = std::move(copy.dense);
+            dead = std::move(copy.dead);
+            slotOf = std::move(copy.slotOf);
+            slots = std::move(copy.slots);
+            freeSlots = std::move(copy.freeSlots);
+            deadCount = copy.deadCount;
+            maxDeadRatio = copy.maxDeadRatio;
+        }
+        return *this;
+    }
+
+    /** @brief Destructor. Stops the background compactor, if any. */
+    ~StableContainer() {
+        stopBackgroundCompaction();
+    }
+
+    /**
+     * @brief Adds a new element and returns a handle to it.
+     *
+     * @param value The element to add.
+     * @return Handle A handle that stays valid until the element is erased.
+     */
+    Handle add(const T& value) {
+        auto guard = lock();
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+        slots[slot].position = dense.size();
+        slots[slot].occupied = true;
+        dense.add(value);
+        dead.push_back(false);
+        slotOf.push_back(slot);
+        return Handle{slot, slots[slot].generation};
+    }
+
+    /**
+     * @brief Erases the element of the handle in O(1) (amortized over compaction).
+     *
+     * @throws std::out_of_range if the handle is invalid or was already erased.
+     */
+    void erase(Handle h) {
+        auto guard = lock();
+        kill(resolve(h).position);
+        afterRemoval();
+    }
+
+    /**
+     * @brief Removes all occurrences of the given element by tombstoning them.
+     *
+     * One scan marks the matches; nothing is shifted until the next compaction.
+     * Handles to the removed elements become invalid.
+     *
+     * @param value The element to remove.
+     * @throws std::runtime_error if the element is not found.
+     */
+    void remove(const T& value) {
+        auto guard = lock();
+        const auto& data = dense.getData();
+        size_t removed = 0;
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (!dead[i] && data[i] == value) {
+                kill(i);
+                ++removed;
+            }
+        }
+        if (removed == 0) {
+            throw std::runtime_error("Element not found in container.");
+        }
+        afterRemoval();
+    }
+
+    /**
+     * @brief Returns a copy of the element of the handle.
+     *
+     * Returned by value: a background compaction may move the element right after the call.
+     *
+     * @throws std::out_of_range if the handle is invalid or was erased.
+     */
+    T get(Handle h) const {
+        auto guard = lock();
+        return dense.getData()[resolve(h).position];
+    }
+
+    /** @brief Returns true if the handle refers to an element that has not been erased. */
+    bool contains(Handle h) const {
+        auto guard = lock();
+        return h.slot < slots.size() && slots[h.slot].occupied && slots[h.slot].generation == h.generation;
+    }
+
+    /** @brief Returns the number of live elements. */
+    size_t size() const {
+        auto guard = lock();
+        return dense.size() - deadCount;
+    }
+
+    /** @brief Returns the number of erased elements not yet compacted away. */
+    size_t tombstones() const {
+        auto guard = lock();
+        return deadCount;
+    }
+
+    /**
+     * @brief Sets the fraction of tombstones in the storage above which erase() compacts.
+     *
+     * @throws std::invalid_argument if ratio is not within (0, 1].
+     */
+    void setMaxDeadRatio(double ratio) {
+        if (!(ratio > 0.0 && ratio <= 1.0)) {
+            throw std::invalid_argument("Dead ratio must be within (0, 1].");
+        }
+        auto guard = lock();
+        maxDeadRatio = ratio;
+        afterRemoval();
+    }
+
+    /**
+     * @brief Removes all tombstones in one stable O(n) pass and updates the slot table.
+     */
+    void compact() {
+        auto guard = lock();
+        compactLocked();
+    }
+
+    /**
+     * @brief Returns the live elements in insertion order, skipping tombstones through the bitmap.
+     *
+     * Never compacts; costs one copy of the bitmap (n bits). Safe to call, and
+     * to iterate, while background compaction runs. The view shares the
+     * storage, so while it exists the next add() or compaction clones the
+     * storage in O(n) first.
+     */
+    LiveView live() const {
+        auto guard = lock();
+        return LiveView(dense, dead, dense.size() - deadCount);
+    }
+
+    /**
+     * @brief Returns a Container of the live elements that later changes never affect.
+     *
+     * This is what the order views are built on (s | ascending, or e.g.
+     * AscendingOrder<T>(s.snapshot())). Without tombstones the copy shares the
+     * storage copy-on-write in O(1); otherwise the live elements are copied
+     * out in O(n), and the container itself is left uncompacted. Safe to call
+     * while background compaction runs. A shared snapshot makes the next add()
+     * or compaction clone the storage in O(n), as with live().
+     */
+    Container<T> snapshot() const {
+        auto guard = lock();
+        Container<T> result = dense;
+        if (deadCount > 0) {
+            result.removeMarked(dead);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Starts a worker thread that compacts whenever the dead ratio is crossed,
+     *        so erase() and remove() never pay for compaction themselves.
+     *
+     * Does nothing if the worker is already running.
+     */
+    void startBackgroundCompaction() {
+        if (compactor) {
+            return;
+        }
+        compactor = std::make_unique<Compactor>();
+        compactor->thread = std::thread([this, c = compactor.get()] {
+            std::unique_lock<std::mutex> guard(c->mutex);
+            while (true) {
+                c->wake.wait(guard, [this, c] { return c->stopping || overThreshold(); });
+                if (c->stopping) {
+                    return;
+                }
+                compactLocked();
+                c->caughtUp.notify_all();
+            }
+        });
+    }
+
+    /**
+     * @brief Stops the background worker; compaction runs inline again afterwards.
+     */
+    void stopBackgroundCompaction() {
+        if (!compactor) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guard(compactor->mutex);
+            compactor->stopping = true;
+        }
+        compactor->wake.notify_one();
+        compactor->thread.join();
+        compactor.reset();
+    }
+
+    /**
+     * @brief Waits until the background compactor has caught up, i.e. the dead
+     *        ratio is no longer crossed, or until the timeout expires.
+     *
+     * Returns at once without a background compactor, since compaction then runs inline.
+     *
+     * @return true if no compaction is pending, false on timeout.
+     */
+    template <typename Rep, typename Period>
+    bool waitForCompaction(std::chrono::duration<Rep, Period> timeout) {
+        if (!compactor) {
+            return !overThreshold();
+        }
+        std::unique_lock<std::mutex> guard(compactor->mutex);
+        return compactor->caughtUp.wait_for(guard, timeout, [this] { return !overThreshold(); });
+    }
+
+    /** @brief Returns true while a background compactor is running. */
+    bool compactsInBackground() const {
+        return compactor != nullptr;
+    }
+
+    /**
+     * @brief Overloads the stream output operator to print the live elements.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const StableContainer& c) {
+        auto guard = c.lock();
+        os << "[";
+        size_t printed = 0;
+        for (size_t i = 0; i < c.dead.size(); ++i) {
+            if (c.dead[i]) continue;
+            os << c.dense.getData()[i];
+            if (++printed < c.dense.size() - c.deadCount) os << ", ";
+        }
+        os << "]";
+        return os;
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_STABLE_CONTAINER_HPP
@@ -0,0 +1,279 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_STATIC_BTREE_HPP
+#define MYCONTAINERS_STATIC_BTREE_HPP
+
+#include "Container.hpp"
+#include "Iterator.hpp"
+#include "AdaptiveSort.hpp"
+#include "SimdKernels.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mycontainers {
+
+namespace detail {
+
+/** @brief Keys per B-tree node: 64 bytes, one cache line, for int and float. */
+constexpr size_t btreeNodeKeys = 16;
+
+/**
+ * @brief Allocator that aligns every buffer to a cache line, so no node straddles two lines.
+ */
+template <typename T>
+struct CacheLineAllocator {
+    using value_type = T;
+
+    CacheLineAllocator() = default;
+    template <typename U>
+    CacheLineAllocator(const CacheLineAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(64)));
+    }
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, std::align_val_t(64));
+    }
+
+    template <typename U>
+    bool operator==(const CacheLineAllocator<U>&) const { return true; }
+};
+
+/**
+ * @brief Number of keys of a node that are smaller than x (or not greater than x if inclusive).
+ */
+template <typename T>
+unsigned nodeRankScalar(const T* node, const T& x, bool inclusive) {
+    unsigned rank = 0;
+    if (inclusive) {
+        for (size_t j = 0; j < btreeNodeKeys; ++j) rank += !(x < node[j]);
+    } else {
+        for (size_t j = 0; j < btreeNodeKeys; ++j) rank += node[j] < x;
+    }
+    return rank;
+}
+
+#ifdef MYCONTAINERS_SIMD_X86
+
+__attribute__((target("avx2,popcnt")))
+inline unsigned nodeRankAvx2(const int* node, int x, bool inclusive) {
+    const __m256i needle = _mm256_set1_epi32(x);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(node));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(node + 8));
+    if (inclusive) {
+        // node[j] <= x  <=>  !(node[j] > x)
+        unsigned greater = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(lo, needle))) |
+                           _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(hi, needle))) << 8;
+        return btreeNodeKeys - _mm_popcnt_u32(greater);
+    }
+    unsigned less = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, lo))) |
+                    _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, hi))) << 8;
+    return _mm_popcnt_u32(less);
+}
+
+__attribute__((target("avx2,popcnt")))
+inline unsigned nodeRankAvx2(const float* node, float x, bool inclusive) {
+    const __m256 needle = _mm256_set1_ps(x);
+    __m256 lo = _mm256_loadu_ps(node);
+    __m256 hi = _mm256_loadu_ps(node + 8);
+    unsigned mask = inclusive
+        ? _mm256_movemask_ps(_mm256_cmp_ps(lo, needle, _CMP_LE_OQ)) | _mm256_movemask_ps(_mm256_cmp_ps(hi, needle, _CMP_LE_OQ)) << 8
+        : _mm256_movemask_ps(_mm256_cmp_ps(lo, needle, _CMP_LT_OQ)) | _mm256_movemask_ps(_mm256_cmp_ps(hi, needle, _CMP_LT_OQ)) << 8;
+    return _mm_popcnt_u32(mask);
+}
+
+#endif // MYCONTAINERS_SIMD_X86
+
+} // namespace detail
+
+/**
+ * @brief A read-only search index over the container's elements: a static B+ tree
+ *        (S+ tree) with 16-key nodes, stored level by level in one aligned buffer.
+ *
+ * The bottom level is the sorted array itself, split into 16-key leaves; every
+ * upper node holds the first key of 16 of its 17 children. A lookup reads one
+ * node per level, log17(n) levels in total, and ranks the key inside a node with
+ * two vector compares and a popcount (AVX2, for int and float) instead of a chain
+ * of unpredictable branches. No child pointers are stored: the children of node k
+ * are nodes 17k .. 17k + 16 of the next level down.
+ *
+ * Iterating the index yields the elements in ascending order. The index keeps
+ * its own copy and stays valid after the container changes.
+ *
+ * @tparam T An arithmetic element type (the padding of partial nodes uses its maximum).
+ */
+template <typename T = int>
+class StaticBTree : public std::ranges::view_interface<StaticBTree<T>> {
+    static_assert(std::is_arithmetic_v<T>, "StaticBTree pads nodes with the type's maximum and needs an arithmetic T.");
+
+private:
+    static constexpr size_t B = detail::btreeNodeKeys;
+
+    /// Padding for partial nodes and for keys of children that do not exist; never smaller than an element.
+    static constexpr T sentinel = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                                        : std::numeric_limits<T>::max();
+
+    std::vector<T, detail::CacheLineAllocator<T>> keys; ///< All levels, leaves first
+    std::vector<size_t> levelOffset; ///< Offset of each level in keys; level 0 holds the leaves
+    size_t elements = 0; ///< Number of elements (leaf keys before the padding)
+
+    static size_t blocks(size_t n) { return (n + B - 1) / B; }
+
+    /** @brief Number of keys (a multiple of B) in the level above a level holding n keys. */
+    static size_t keysAbove(size_t n) { return (blocks(n) + B) / (B + 1) * B; }
+
+    void build(const T* sorted, size_t n) {
+        elements = n;
+        if (n == 0) {
+            return;
+        }
+        std::vector<size_t> levelSize;
+        for (size_t m = n;; m = keysAbove(m)) {
+            levelSize.push_back(blocks(m) * B);
+            if (m <= B) break;
+        }
+        levelOffset.push_back(0);
+        for (size_t h = 1; h < levelSize.size(); ++h) {
+            levelOffset.push_back(levelOffset[h - 1] + levelSize[h - 1]);
+        }
+        keys.assign(levelOffset.back() + levelSize.back(), sentinel);
+        std::copy(sorted, sorted + n, keys.begin());
+
+        for (size_t h = 1; h < levelSize.size(); ++h) {
+            for (size_t i = 0; i < levelSize[h]; ++i) {
+                // Key j of node k is the smallest key under child j + 1: follow the
+                // leftmost path from that child down to its first leaf.
+                size_t child = (i / B) * (B + 1) + i % B + 1;
+                for (size_t l = 1; l < h; ++l) {
+                    child *= B + 1;
+                }
+                keys[levelOffset[h] + i] = child * B < n ? sorted[child * B] : sentinel;
+            }
+        }
+    }
+
+    static unsigned nodeRank(const T* node, const T& x, bool inclusive) {
+#ifdef MYCONTAINERS_SIMD_X86
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>) {
+            if (simd::activeIsa() != simd::Isa::Scalar) {
+                return detail::nodeRankAvx2(node, x, inclusive);
+            }
+        }
+#endif
+        return detail::nodeRankScalar(node, x, inclusive);
+    }
+
+    /** @brief Number of elements smaller than x, or not greater than x if inclusive. */
+    size_t search(const T& x, bool inclusive) const {
+        if (elements == 0) {
+            return 0;
+        }
+        if (inclusive && !(x < sentinel)) {
+            return elements; // the padding itself would be counted
+        }
+        size_t k = 0; // offset of the current node within its level
+        for (size_t h = levelOffset.size() - 1; h > 0; --h) {
+            size_t i = nodeRank(keys.data() + levelOffset[h] + k, x, inclusive);
+            k = k * (B + 1) + i * B;
+        }
+        return std::min(elements, k + nodeRank(keys.data() + k, x, inclusive));
+    }
+
+public:
+    using const_iterator = Iterator<const T*>;
+
+    /**
+     * @brief Builds the index from a container's elements.
+     *
+     * Sorted storage (a sorted container or its sorted index) is read directly;
+     * otherwise a copy is sorted first.
+     *
+     * @param c The container to index.
+     */
+    template <size_t N>
+    explicit StaticBTree(const Container<T, N>& c) {
+        const auto& data = c.getData();
+        if (c.isSorted()) {
+            build(data.data(), data.size());
+        } else if (c.hasSortedIndex()) {
+            build(c.getSortedIndex().data(), data.size());
+        } else {
+            std::vector<T> sorted(data.begin(), data.end());
+            adaptiveSort(sorted.data(), sorted.data() + sorted.size());
+            build(sorted.data(), sorted.size());
+        }
+    }
+
+    /** @brief Returns the number of elements. */
+    size_t size() const {
+        return elements;
+    }
+
+    /** @brief Returns the number of elements strictly smaller than value. */
+    size_t rank(const T& value) const {
+        return search(value, false);
+    }
+
+    /** @brief Returns the number of elements equal to value. */
+    size_t count(const T& value) const {
+        return search(value, true) - search(value, false);
+    }
+
+    /**
+     * @brief Returns the k-th smallest element (0-based).
+     *
+     * @throws std::out_of_range if k >= size().
+     */
+    const T& select(size_t k) const {
+        if (k >= elements) {
+            throw std::out_of_range("Rank out of range.");
+        }
+        return keys[k];
+    }
+
+    /** @brief Returns an iterator to the first element not less than value, or end(). */
+    const_iterator lower_bound(const T& value) const {
+        return const_iterator(keys.data() + search(value, false), keys.data() + elements);
+    }
+
+    /** @brief Returns an iterator to the first element greater than value, or end(). */
+    const_iterator upper_bound(const T& value) const {
+        return const_iterator(keys.data() + search(value, true), keys.data() + elements);
+    }
+
+    /** @brief Returns the range of elements equal to value. */
+    std::pair<const_iterator, const_iterator> equal_range(const T& value) const {
+        return {lower_bound(value), upper_bound(value)};
+    }
+
+    /** @brief Returns true if an element equal to value exists. */
+    bool contains(const T& value) const {
+        size_t r = search(value, false);
+        return r < elements && !(value < keys[r]);
+    }
+
+    /**
+     * @brief Returns an iterator to the smallest element.
+     */
+    const_iterator begin() const {
+        return const_iterator(keys.data(), keys.data() + elements);
+    }
+
+    /**
+     * @brief Returns an iterator past the largest element.
+     */
+    const_iterator end() const {
+        return const_iterator(keys.data() + elements, keys.data() + elements);
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_STATIC_BTREE_HPP
@@ -0,0 +1,109 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_STREAM_ORDERS_HPP
+#define MYCONTAINERS_STREAM_ORDERS_HPP
+
+#include "Generator.hpp"
+#include "ExternalSort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * Streaming counterparts of the order views.
+ *
+ * Each function consumes its source incrementally, pulling the next element
+ * only when the caller advances, so producers do not need a materialized
+ * Container. Sources are taken by value and kept alive by the coroutine: pass
+ * views (e.g. an Order<T> over a container) or move generators in.
+ */
+
+namespace detail {
+
+template <typename R>
+Generator<std::ranges::range_value_t<R>> streamReverseImpl(R source, size_t window) {
+    std::vector<std::ranges::range_value_t<R>> buffer;
+    buffer.reserve(window);
+    for (auto&& value : source) {
+        buffer.push_back(value);
+        if (buffer.size() == window) {
+            for (auto it = buffer.rbegin(); it != buffer.rend(); ++it) {
+                co_yield *it;
+            }
+            buffer.clear();
+        }
+    }
+    for (auto it = buffer.rbegin(); it != buffer.rend(); ++it) {
+        co_yield *it;
+    }
+}
+
+template <typename R>
+Generator<std::ranges::range_value_t<R>> streamAscendingImpl(R source, ExternalSortConfig config) {
+    ExternalAscendingOrder<std::ranges::range_value_t<R>> sorted(std::move(source), std::move(config));
+    for (const auto& value : sorted) {
+        co_yield value;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Streams the source in arrival order (the streaming form of Order).
+ */
+template <std::ranges::input_range R>
+Generator<std::ranges::range_value_t<R>> streamOrder(R source) {
+    for (auto&& value : source) {
+        co_yield value;
+    }
+}
+
+/**
+ * @brief Streams the source reversed within consecutive windows of a fixed size.
+ *
+ * For example, with window 3 the stream 1 2 3 4 5 yields 3 2 1 5 4.
+ * Memory is bounded by the window; a window covering the whole stream gives ReverseOrder.
+ *
+ * @throws std::invalid_argument if window is 0.
+ */
+template <std::ranges::input_range R>
+Generator<std::ranges::range_value_t<R>> streamReverse(R source, size_t window) {
+    if (window == 0) {
+        throw std::invalid_argument("Window size must be positive.");
+    }
+    return detail::streamReverseImpl(std::move(source), window);
+}
+
+/**
+ * @brief Streams the source in ascending order, holding at most chunkSize elements in memory.
+ *
+ * A thin wrapper over ExternalAscendingOrder: chunks of chunkSize elements are
+ * sorted as they arrive and spilled to the temporary directory, then k-way
+ * merged once the source is exhausted. A stream that fits in one chunk never
+ * touches the disk. Like ExternalAscendingOrder, it needs a trivially copyable element type.
+ *
+ * @throws std::invalid_argument if chunkSize is 0.
+ * @throws std::runtime_error (when iterated) if a spill file cannot be written.
+ */
+template <std::ranges::input_range R>
+Generator<std::ranges::range_value_t<R>> streamAscending(R source, size_t chunkSize) {
+    using T = std::ranges::range_value_t<R>;
+    if (chunkSize == 0) {
+        throw std::invalid_argument("Chunk size must be positive.");
+    }
+    ExternalSortConfig config;
+    config.memoryBudget = std::min(chunkSize, std::numeric_limits<size_t>::max() / sizeof(T)) * sizeof(T);
+    // Sixteen merge buffers per budget, so a merge pass covers sixteen chunks.
+    config.blockSize = std::clamp(config.memoryBudget / 16, sizeof(T), config.blockSize);
+    return detail::streamAscendingImpl(std::move(source), std::move(config));
+}
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_STREAM_ORDERS_HPP
@@ -0,0 +1,114 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_STRIDED_ORDER_HPP
+#define MYCONTAINERS_STRIDED_ORDER_HPP
+
+#include "Container.hpp"
+#include "Iterator.hpp"
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+
+namespace mycontainers {
+
+/**
+ * @brief An iterator that visits every stride-th element of the container, starting at offset.
+ *
+ * For example, if the container contains [7, 15, 6, 1, 2], a stride of 2
+ * yields 7, 6, 2 and a stride of 2 with offset 1 yields 15, 1.
+ *
+ * O(1) to construct, no copy: like Order, the view reads the container's
+ * storage, must not outlive the container and is invalidated by add() and remove().
+ *
+ * @tparam T The type of the container elements.
+ * @tparam N Inline capacity of the container (see Container).
+ */
+template <typename T = int, size_t N = 0>
+class StridedOrder : public std::ranges::view_interface<StridedOrder<T, N>> {
+
+private:
+    /**
+     * @brief Random-access position: the i-th visited element is first[i * stride].
+     */
+    class Cursor {
+    private:
+        const T* first = nullptr;
+        size_t stride = 1;
+        size_t index = 0;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        Cursor() = default;
+        Cursor(const T* f, size_t s, size_t i) : first(f), stride(s), index(i) {}
+
+        reference operator*() const { return first[index * stride]; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        Cursor& operator++() { ++index; return *this; }
+        Cursor operator++(int) { Cursor t = *this; ++index; return t; }
+        Cursor& operator--() { --index; return *this; }
+        Cursor operator--(int) { Cursor t = *this; --index; return t; }
+        Cursor& operator+=(difference_type n) { index += n; return *this; }
+        Cursor& operator-=(difference_type n) { index -= n; return *this; }
+
+        friend Cursor operator+(Cursor c, difference_type n) { return c += n; }
+        friend Cursor operator+(difference_type n, Cursor c) { return c += n; }
+        friend Cursor operator-(Cursor c, difference_type n) { return c -= n; }
+        friend difference_type operator-(const Cursor& a, const Cursor& b) {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+
+        bool operator==(const Cursor& other) const { return index == other.index; }
+        auto operator<=>(const Cursor& other) const { return index <=> other.index; }
+    };
+
+    const T* first = nullptr; ///< First visited element
+    size_t stride = 1;        ///< Distance between visited elements
+    size_t length = 0;        ///< Number of visited elements
+
+public:
+    using const_iterator = Iterator<Cursor>;
+
+    /**
+     * @brief Constructor that takes a reference to a container, a stride and a starting offset.
+     *
+     * @param c The container to traverse.
+     * @param stride Distance between visited elements (1 visits every element).
+     * @param offset Position of the first visited element; an offset past the end gives an empty view.
+     * @throws std::invalid_argument if stride is 0.
+     */
+    StridedOrder(const Container<T, N>& c, size_t stride, size_t offset = 0) : stride(stride) {
+        if (stride == 0) {
+            throw std::invalid_argument("Stride must be positive.");
+        }
+        const auto& data = c.getData();
+        if (offset < data.size()) {
+            first = data.data() + offset;
+            length = (data.size() - offset + stride - 1) / stride;
+        }
+    }
+
+    /**
+     * @brief Returns an iterator to the element at the offset.
+     */
+    const_iterator begin() const {
+        return const_iterator(Cursor(first, stride, 0), Cursor(first, stride, length));
+    }
+
+    /**
+     * @brief Returns an iterator past the last visited element.
+     */
+    const_iterator end() const {
+        return const_iterator(Cursor(first, stride, length), Cursor(first, stride, length));
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_STRIDED_ORDER_HPP
@@ -0,0 +1,140 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_THREAD_POOL_HPP
+#define MYCONTAINERS_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mycontainers {
+
+/**
+ * @brief A fixed set of worker threads that run submitted tasks in FIFO order.
+ *
+ * submit() returns a std::future for the task's result; an exception thrown by
+ * the task is rethrown from future::get(). The destructor finishes the queued
+ * tasks and joins the workers. A task that waits on other tasks of the same
+ * pool must help with tryRunOne() while it waits (as the parallel algorithms
+ * do), otherwise every worker might end up waiting.
+ *
+ * shared() is the process-wide pool used by the parallel algorithms by default.
+ */
+class ThreadPool {
+
+private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    void work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> guard(mutex);
+                wake.wait(guard, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) {
+                    return; // stopping, and the queue is drained
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+public:
+    /**
+     * @brief Starts the given number of worker threads.
+     *
+     * @param threads Number of workers; defaults to the hardware concurrency.
+     * @throws std::invalid_argument if threads is 0.
+     */
+    explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency())) {
+        if (threads == 0) {
+            throw std::invalid_argument("Thread pool needs at least one thread.");
+        }
+        workers.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** @brief Destructor. Runs the tasks still queued, then joins the workers. */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    /** @brief Returns the number of worker threads. */
+    size_t size() const {
+        return workers.size();
+    }
+
+    /**
+     * @brief Queues fn to run on a worker.
+     *
+     * @return std::future for fn's result (or exception).
+     */
+    template <typename Fn>
+    std::future<std::invoke_result_t<Fn>> submit(Fn fn) {
+        // packaged_task is move-only; the shared_ptr makes it fit in a std::function.
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Fn>()>>(std::move(fn));
+        auto result = task->get_future();
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            tasks.emplace_back([task] { (*task)(); });
+        }
+        wake.notify_one();
+        return result;
+    }
+
+    /**
+     * @brief Runs the oldest queued task on the calling thread, if there is one.
+     *
+     * @return true if a task was run, false if the queue was empty.
+     */
+    bool tryRunOne() {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (tasks.empty()) {
+                return false;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+        return true;
+    }
+
+    /** @brief Returns the process-wide pool, created on first use with one worker per hardware thread. */
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+};
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_THREAD_POOL_HPP
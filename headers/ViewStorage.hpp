@@ -0,0 +1,63 @@
+// maayan4282gmail.com
+
+#ifndef MYCONTAINERS_VIEW_STORAGE_HPP
+#define MYCONTAINERS_VIEW_STORAGE_HPP
+
+#include <memory>
+#include <utility>
+
+namespace mycontainers {
+
+namespace detail {
+
+/**
+ * @brief The elements an order view computed for itself, shared by every copy of the view.
+ *
+ * std::ranges::view promises O(1) copies, and the standard adaptors copy views
+ * freely (`v | std::views::take(3)` copies v), so a view never copies the
+ * elements it owns: they are built once, then frozen behind a shared_ptr.
+ *
+ * @tparam Storage The buffer type, e.g. std::vector<T>.
+ * @tparam Shared False keeps the buffer inside the view instead; views over
+ *         inline containers (N > 0) use it so they never allocate, like the container.
+ */
+template <typename Storage, bool Shared = true>
+class ViewStorage {
+
+private:
+    std::shared_ptr<const Storage> shared;
+
+public:
+    ViewStorage() = default;
+
+    explicit ViewStorage(Storage s) : shared(std::make_shared<const Storage>(std::move(s))) {}
+
+    /** @brief Returns the buffer; an empty one for a default-constructed storage. */
+    const Storage& get() const {
+        static const Storage empty;
+        return shared ? *shared : empty;
+    }
+};
+
+template <typename Storage>
+class ViewStorage<Storage, false> {
+
+private:
+    Storage owned;
+
+public:
+    ViewStorage() = default;
+
+    explicit ViewStorage(Storage s) : owned(std::move(s)) {}
+
+    /** @brief Returns the buffer. */
+    const Storage& get() const {
+        return owned;
+    }
+};
+
+} // namespace detail
+
+} // namespace mycontainers
+
+#endif // MYCONTAINERS_VIEW_STORAGE_HPP
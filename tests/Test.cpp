@@ -10,6 +10,38 @@
 #include "../headers/ReverseOrder.hpp"
 #include "../headers/SideCrossOrder.hpp"
 #include "../headers/MiddleOutOrder.hpp"
+#include "../headers/EytzingerOrder.hpp"
+#include "../headers/DistinctOrder.hpp"
+#include "../headers/FrequencyOrder.hpp"
+#include "../headers/ShuffleOrder.hpp"
+#include "../headers/StridedOrder.hpp"
+#include "../headers/SampleOrder.hpp"
+#include "../headers/ChunkedIteration.hpp"
+#include "../headers/ThreadPool.hpp"
+#include "../headers/Parallel.hpp"
+#include "../headers/SimdKernels.hpp"
+#include "../headers/SimdSort.hpp"
+#include "../headers/AdaptiveSort.hpp"
+#include "../headers/Adaptors.hpp"
+#include "../headers/StreamOrders.hpp"
+#include "../headers/ExternalSort.hpp"
+#include "../headers/SegmentedContainer.hpp"
+#include "../headers/SmallVector.hpp"
+#include "../headers/PersistentContainer.hpp"
+#include "../headers/StableContainer.hpp"
+#include "../headers/StaticBTree.hpp"
+#include "../headers/BloomFilter.hpp"
+#include <filesystem>
+#include <ranges>
+#include <limits>
+#include <map>
+#include <optional>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 
 using namespace mycontainers;
@@ -85,6 +117,360 @@ TEST_CASE("Copy constructor and assignment operator") {
     CHECK_NOTHROW(assigned.remove(2));
 }
 
+TEST_CASE("Select and rank without a sorted index") {
+    Container<int> c;
+    c.add(7);
+    c.add(15);
+    c.add(6);
+    c.add(1);
+    c.add(2);
+
+    CHECK(c.select(0) == 1);
+    CHECK(c.select(2) == 6);
+    CHECK(c.select(4) == 15);
+    CHECK_THROWS_AS(c.select(5), std::out_of_range);
+    CHECK(c.rank(7) == 3);
+    CHECK(c.rank(0) == 0);
+    CHECK(c.rank(100) == 5);
+}
+
+TEST_CASE("Sorted index is maintained across add and remove") {
+    Container<int> c;
+    c.add(5);
+    c.add(3);
+    c.buildSortedIndex();
+    CHECK(c.hasSortedIndex());
+    c.add(4);
+    c.add(3);
+    c.add(9);
+    CHECK(c.getSortedIndex() == std::vector<int>{3, 3, 4, 5, 9});
+    c.remove(3);
+    CHECK(c.getSortedIndex() == std::vector<int>{4, 5, 9});
+    CHECK(c.select(1) == 5);
+    CHECK(c.rank(9) == 2);
+
+    c.dropSortedIndex();
+    CHECK_FALSE(c.hasSortedIndex());
+    CHECK_THROWS_AS(c.getSortedIndex(), std::logic_error);
+    CHECK(c.select(1) == 5);
+}
+
+TEST_CASE("Quantiles with and without a sorted index") {
+    Container<int> c;
+    for (int i = 100; i >= 1; --i) {
+        c.add(i);
+    }
+
+    CHECK(c.quantile(0.0) == 1);
+    CHECK(c.quantile(1.0) == 100);
+    CHECK(c.quantile(0.5) == 50);
+
+    std::vector<int> expected = {50, 90, 99, 1, 50};
+    CHECK(c.quantiles({0.5, 0.9, 0.99, 0.0, 0.5}) == expected);
+    c.buildSortedIndex();
+    CHECK(c.quantiles({0.5, 0.9, 0.99, 0.0, 0.5}) == expected);
+
+    CHECK_THROWS_AS(c.quantile(1.5), std::invalid_argument);
+    Container<int> empty;
+    CHECK_THROWS_AS(empty.quantiles({0.5}), std::out_of_range);
+}
+
+TEST_CASE("Running aggregates follow add and remove") {
+    Container<int> c;
+    CHECK_THROWS_AS(c.min(), std::out_of_range);
+    CHECK_THROWS_AS(c.max(), std::out_of_range);
+    CHECK(c.sum() == 0);
+
+    c.add(7);
+    c.add(15);
+    c.add(6);
+    c.add(1);
+    c.add(15);
+    CHECK(c.min() == 1);
+    CHECK(c.max() == 15);
+    CHECK(c.sum() == 44);
+    CHECK(c.count(15) == 2);
+    CHECK(c.count(99) == 0);
+
+    c.remove(15);
+    CHECK(c.max() == 7);
+    CHECK(c.sum() == 14);
+    c.remove(1);
+    CHECK(c.min() == 6);
+
+    c.buildSortedIndex();
+    c.add(6);
+    CHECK(c.count(6) == 2);
+}
+
+TEST_CASE("Floating-point sum stays exact after removing infinities and large values") {
+    Container<double> c;
+    c.add(1.0);
+    c.add(std::numeric_limits<double>::infinity());
+    CHECK(c.sum() == std::numeric_limits<double>::infinity());
+    c.remove(std::numeric_limits<double>::infinity());
+    CHECK(c.sum() == 1.0);
+
+    Container<double> big;
+    big.add(1e17);
+    big.add(1.0); // absorbed: 1e17 + 1 rounds to 1e17
+    big.remove(1e17);
+    CHECK(big.sum() == 1.0);
+
+    big.add(1e17);
+    big.add(2.0);
+    CHECK(big.removeMarked({false, true, false}) == 1);
+    CHECK(big.sum() == 3.0);
+}
+
+TEST_CASE("Aggregates on string container") {
+    Container<std::string> c;
+    c.add("monkey");
+    c.add("apple");
+    c.add("zebra");
+    CHECK(c.min() == "apple");
+    CHECK(c.max() == "zebra");
+    c.remove("zebra");
+    CHECK(c.max() == "monkey");
+    CHECK(c.count("apple") == 1);
+}
+
+TEST_CASE("Container contains") {
+    Container<int> c;
+    CHECK_FALSE(c.contains(3));
+    c.add(3);
+    c.add(8);
+    CHECK(c.contains(8));
+    CHECK_FALSE(c.contains(4));
+    c.buildSortedIndex();
+    CHECK(c.contains(3));
+    CHECK_FALSE(c.contains(4));
+}
+
+// ------------------ SIMD Kernel Tests ------------------
+
+TEST_CASE_TEMPLATE("SIMD kernels agree with the scalar path at every ISA level", T, int, float, double) {
+    const simd::Isa levels[] = {simd::Isa::Scalar, simd::Isa::Avx2, simd::Isa::Avx512};
+    for (simd::Isa level : levels) {
+        simd::setIsa(level);
+        for (size_t n : {1u, 7u, 8u, 17u, 100u, 1001u}) {
+            std::vector<T> values(n);
+            for (size_t i = 0; i < n; ++i) {
+                values[i] = static_cast<T>((i * 37 + 11) % 13);
+            }
+            std::vector<T> expected = values;
+            expected.erase(std::remove(expected.begin(), expected.end(), T(5)), expected.end());
+
+            CHECK(simd::count(values.data(), n, T(5)) == static_cast<size_t>(std::count(values.begin(), values.end(), T(5))));
+            CHECK(simd::contains(values.data(), n, T(12)) == (std::find(values.begin(), values.end(), T(12)) != values.end()));
+            CHECK_FALSE(simd::contains(values.data(), n, T(42)));
+
+            auto [lo, hi] = simd::minMax(values.data(), n);
+            CHECK(lo == *std::min_element(values.begin(), values.end()));
+            CHECK(hi == *std::max_element(values.begin(), values.end()));
+
+            values.resize(simd::removeValue(values.data(), n, T(5)));
+            CHECK(values == expected);
+        }
+    }
+    simd::setIsa(simd::Isa::Avx512);
+}
+
+TEST_CASE_TEMPLATE("SIMD sort matches std::sort", T, int, float) {
+    const simd::Isa levels[] = {simd::Isa::Scalar, simd::Isa::Avx2};
+    for (simd::Isa level : levels) {
+        simd::setIsa(level);
+        for (size_t n : {0u, 1u, 15u, 16u, 17u, 100u, 3000u, 70000u}) { // 70000: past the cached scratch buffer
+            std::vector<std::vector<T>> inputs(5, std::vector<T>(n));
+            for (size_t i = 0; i < n; ++i) {
+                inputs[0][i] = static_cast<T>((i * 7919 + 13) % 1009) - static_cast<T>(500);
+                inputs[1][i] = static_cast<T>(i % 3);
+                inputs[2][i] = static_cast<T>(4);
+                inputs[3][i] = static_cast<T>(i);
+                inputs[4][i] = static_cast<T>(n - i);
+            }
+            if (n > 2) {
+                inputs[0][1] = std::numeric_limits<T>::max();
+                inputs[0][2] = std::numeric_limits<T>::lowest();
+            }
+            for (auto values : inputs) {
+                std::vector<T> expected = values;
+                std::sort(expected.begin(), expected.end());
+                simd::sort(values.data(), values.data() + values.size());
+                CHECK(values == expected);
+            }
+        }
+    }
+    simd::setIsa(simd::Isa::Avx512);
+}
+
+TEST_CASE("SIMD sort of floats keeps every -0.0 and +0.0") {
+    auto bits = [](const std::vector<float>& values) {
+        std::vector<std::uint32_t> out(values.size());
+        std::memcpy(out.data(), values.data(), values.size() * sizeof(float));
+        std::sort(out.begin(), out.end());
+        return out;
+    };
+    const simd::Isa levels[] = {simd::Isa::Scalar, simd::Isa::Avx2};
+    for (simd::Isa level : levels) {
+        simd::setIsa(level);
+        std::mt19937 rng(3);
+        for (size_t n = 17; n < 200; ++n) {
+            // Small mixed ranges, so zeros of both signs meet inside the sorting network.
+            const float pool[] = {-0.0f, 0.0f, -1.0f, 1.0f};
+            std::vector<float> values(n);
+            for (float& x : values) {
+                x = pool[rng() % 4];
+            }
+            std::vector<float> expected = values;
+            std::sort(expected.begin(), expected.end());
+            simd::sort(values.data(), values.data() + values.size());
+            CHECK(values == expected);             // same values in the same order
+            CHECK(bits(values) == bits(expected)); // and the same zeros: a permutation of the input
+        }
+    }
+    simd::setIsa(simd::Isa::Avx512);
+}
+
+TEST_CASE("DescendingOrder over floats uses the vectorized sort") {
+    Container<float> c;
+    for (int i = 0; i < 40; ++i) {
+        c.add(static_cast<float>((i * 17) % 23) / 2.0f);
+    }
+    std::vector<float> expected(c.getData());
+    std::sort(expected.begin(), expected.end(), std::greater<float>());
+
+    DescendingOrder<float> desc(c);
+    std::vector<float> result(desc.begin(), desc.end());
+    CHECK(result == expected);
+}
+
+// ------------------ Adaptive Sort Tests ------------------
+
+TEST_CASE("Adaptive sort detects sorted and reverse-sorted input") {
+    std::vector<int> sorted = {1, 2, 2, 3, 8};
+    CHECK(detectRuns(sorted.data(), sorted.data() + sorted.size(), std::less<int>()).size() == 2);
+    adaptiveSort(sorted.data(), sorted.data() + sorted.size());
+    CHECK(sorted == std::vector<int>{1, 2, 2, 3, 8});
+
+    std::vector<int> reversed = {9, 7, 4, 0, -3};
+    adaptiveSort(reversed.data(), reversed.data() + reversed.size());
+    CHECK(reversed == std::vector<int>{-3, 0, 4, 7, 9});
+
+    std::vector<int> descending = {1, 3, 5, 9};
+    adaptiveSort(descending.data(), descending.data() + descending.size(), std::greater<int>());
+    CHECK(descending == std::vector<int>{9, 5, 3, 1});
+}
+
+TEST_CASE("Adaptive sort merges runs stably") {
+    struct Event {
+        int time;
+        int seq;
+    };
+    std::vector<Event> events;
+    int seq = 0;
+    for (int run = 0; run < 5; ++run) {
+        for (int t = 0; t < 100; ++t) {
+            events.push_back({t / 3 + run * 7, seq++});
+        }
+    }
+    auto byTime = [](const Event& a, const Event& b) { return a.time < b.time; };
+    std::vector<Event> expected = events;
+    std::stable_sort(expected.begin(), expected.end(), byTime);
+
+    adaptiveSort(events.data(), events.data() + events.size(), byTime);
+    bool same = std::equal(events.begin(), events.end(), expected.begin(),
+                           [](const Event& a, const Event& b) { return a.time == b.time && a.seq == b.seq; });
+    CHECK(same);
+}
+
+TEST_CASE("Adaptive sort falls back on random input") {
+    std::vector<std::string> words;
+    for (int i = 0; i < 200; ++i) {
+        words.push_back(std::to_string((i * 7919) % 211));
+    }
+    std::vector<std::string> expected = words;
+    std::sort(expected.begin(), expected.end());
+    adaptiveSort(words.data(), words.data() + words.size());
+    CHECK(words == expected);
+}
+
+TEST_CASE("Container tracks sorted runs on add and remove") {
+    Container<int> c;
+    CHECK(c.isSorted());
+    CHECK(c.getRunStarts().empty());
+    c.add(1);
+    c.add(3);
+    c.add(3);
+    CHECK(c.isSorted());
+    c.add(2);
+    c.add(5);
+    c.add(0);
+    CHECK_FALSE(c.isSorted());
+    CHECK(c.getRunStarts() == std::vector<size_t>{0, 3, 5});
+    c.remove(2);
+    CHECK(c.getRunStarts() == std::vector<size_t>{0, 4});
+    c.remove(0);
+    CHECK(c.isSorted());
+}
+
+TEST_CASE("Container keeps a bounded number of run starts") {
+    Container<int> c;
+    for (int i = 1000; i > 0; --i) {
+        c.add(i);
+    }
+    CHECK_FALSE(c.isSorted());
+    CHECK_FALSE(c.allRunsTracked());
+    CHECK(c.getRunStarts().size() == Container<int>::maxTrackedRuns);
+    std::vector<int> expected(1000);
+    std::iota(expected.begin(), expected.end(), 1);
+    AscendingOrder<int> asc(c);
+    CHECK(std::vector<int>(asc.begin(), asc.end()) == expected);
+
+    for (int i = 2; i <= 1000; ++i) {
+        c.remove(i);
+    }
+    CHECK(c.isSorted());
+    CHECK(c.allRunsTracked());
+    CHECK(c.getRunStarts() == std::vector<size_t>{0});
+}
+
+TEST_CASE("Sorted containers are viewed without copying") {
+    Container<int> c;
+    for (int i = 0; i < 10; ++i) {
+        c.add(i * 2);
+    }
+    AscendingOrder<int> asc(c);
+    CHECK(&*asc.begin() == &c.getData().front());
+
+    DescendingOrder<int> desc(c);
+    CHECK(&*desc.begin() == &c.getData().back());
+    std::vector<int> result(desc.begin(), desc.end());
+    CHECK(result == std::vector<int>{18, 16, 14, 12, 10, 8, 6, 4, 2, 0});
+
+    c.add(1);
+    c.buildSortedIndex();
+    AscendingOrder<int> indexed(c);
+    CHECK(&*indexed.begin() == &c.getSortedIndex().front());
+    CHECK(*indexed.begin() == 0);
+    CHECK(*++indexed.begin() == 1);
+}
+
+TEST_CASE("AscendingOrder merges the runs tracked by the container") {
+    Container<int> c;
+    for (int run = 0; run < 3; ++run) {
+        for (int i = 0; i < 40; ++i) {
+            c.add(i * 3 + run);
+        }
+    }
+    CHECK(c.getRunStarts().size() == 3);
+    AscendingOrder<int> asc(c);
+    std::vector<int> result(asc.begin(), asc.end());
+    std::vector<int> expected(c.getData());
+    std::sort(expected.begin(), expected.end());
+    CHECK(result == expected);
+}
+
 // ------------------ Order Tests ------------------
 
 TEST_CASE("Order iteration yields elements in insertion order") {
@@ -407,6 +793,18 @@ TEST_CASE("ReverseOrder iterator comparison and traversal") {
     CHECK(count == c.size());
 }
 
+TEST_CASE("ReverseOrder reads the container storage without copying") {
+    Container<int> c;
+    c.add(1);
+    c.add(2);
+    c.add(3);
+
+    ReverseOrder<int> rev(c);
+    CHECK(&*rev.begin() == &c.getData().back());
+    c.add(4);
+    CHECK(*rev.begin() == 4);
+}
+
 // ------------------ Container Tests ------------------
 
 TEST_CASE("SideCrossOrder basic iteration") {
@@ -640,4 +1038,1430 @@ TEST_CASE("MiddleOutOrder with duplicate elements") {
     }
 
     CHECK(result == std::vector<int>{3, 1, 1, 3, 2});
-}
\ No newline at end of file
+}
+
+// ------------------ Ranges Tests ------------------
+
+template <typename View>
+constexpr bool isRandomAccessView = std::ranges::view<View> && std::ranges::sized_range<View> &&
+                                    std::ranges::random_access_range<View> && std::ranges::common_range<View>;
+
+static_assert(isRandomAccessView<Order<int>>);
+static_assert(isRandomAccessView<AscendingOrder<int>>);
+static_assert(isRandomAccessView<DescendingOrder<int>>);
+static_assert(isRandomAccessView<ReverseOrder<int>>);
+static_assert(isRandomAccessView<SideCrossOrder<int>>);
+static_assert(isRandomAccessView<MiddleOutOrder<std::string>>);
+
+TEST_CASE("Orders compose with standard view adaptors") {
+    Container<int> c;
+    c.add(7);
+    c.add(15);
+    c.add(6);
+    c.add(1);
+    c.add(2);
+
+    auto firstTwo = c | ascending | std::views::take(2);
+    CHECK(std::vector<int>(firstTwo.begin(), firstTwo.end()) == std::vector<int>{1, 2});
+
+    auto evens = c | reversed | std::views::filter([](int x) { return x % 2 == 0; });
+    CHECK(std::vector<int>(evens.begin(), evens.end()) == std::vector<int>{2, 6});
+
+    auto doubled = c | side_cross | std::views::transform([](int x) { return x * 2; });
+    CHECK(std::ranges::size(doubled) == 5);
+    CHECK(doubled[1] == 30);
+
+    auto desc = c | descending;
+    CHECK(desc.size() == 5);
+    CHECK(desc[0] == 15);
+    CHECK(desc.back() == 1);
+    CHECK((desc.end() - desc.begin()) == 5);
+    CHECK_THROWS_AS(desc.begin()[5], std::out_of_range);
+
+    CHECK(std::ranges::distance(c | in_order) == 5);
+    CHECK((c | middle_out).front() == 6);
+}
+
+TEST_CASE("Ascending and descending views do not change with their container, sorted or not") {
+    auto build = [](std::initializer_list<int> values) {
+        Container<int> c;
+        for (int x : values) {
+            c.add(x);
+        }
+        return c;
+    };
+    Container<int> sorted = build({1, 2, 6, 7, 15});
+    Container<int> indexed = build({7, 15, 6, 1, 2});
+    indexed.buildSortedIndex();
+    Container<int> unsorted = build({7, 15, 6, 1, 2});
+
+    for (Container<int>* c : {&sorted, &indexed, &unsorted}) {
+        auto asc = *c | ascending;
+        auto desc = *c | descending;
+        AscendingOrder<int> firstTwo(*c, 2);
+        DescendingOrder<int> lastTwo(*c, 2);
+        c->add(0);
+        c->remove(15);
+        c->add(20);
+        CHECK(std::vector<int>(asc.begin(), asc.end()) == std::vector<int>{1, 2, 6, 7, 15});
+        CHECK(std::vector<int>(desc.begin(), desc.end()) == std::vector<int>{15, 7, 6, 2, 1});
+        CHECK(std::vector<int>(firstTwo.begin(), firstTwo.end()) == std::vector<int>{1, 2});
+        CHECK(std::vector<int>(lastTwo.begin(), lastTwo.end()) == std::vector<int>{15, 7});
+    }
+    CHECK(sorted.getData() == std::vector<int>{1, 2, 6, 7, 0, 20});
+
+    // The views may also outlive their container, whichever storage they took.
+    std::optional<AscendingOrder<int>> kept;
+    {
+        Container<int> scoped = build({3, 4, 5});
+        kept.emplace(scoped);
+    }
+    CHECK(std::vector<int>(kept->begin(), kept->end()) == std::vector<int>{3, 4, 5});
+}
+
+TEST_CASE("Copies of owning orders share their elements") {
+    Container<int> c;
+    for (int x : {7, 15, 6, 1, 2, 7}) {
+        c.add(x);
+    }
+    auto asc = c | ascending;
+    auto ascCopy = asc;
+    CHECK(&*ascCopy.begin() == &*asc.begin());
+    auto firstThree = asc | std::views::take(3); // takes the view by value
+    CHECK(&*firstThree.begin() == &*asc.begin());
+
+    auto desc = c | descending;
+    CHECK(&*DescendingOrder<int>(desc).begin() == &*desc.begin());
+    auto cross = c | side_cross;
+    CHECK(&*SideCrossOrder<int>(cross).begin() == &*cross.begin());
+    auto middle = c | middle_out;
+    CHECK(&*MiddleOutOrder<int>(middle).begin() == &*middle.begin());
+    auto eyt = c | eytzinger;
+    CHECK(&*EytzingerOrder<int>(eyt).begin() == &*eyt.begin());
+    auto counts = c | distinct;
+    CHECK(&DistinctOrder<int>(counts).getCounts() == &counts.getCounts());
+    auto frequent = c | most_frequent(2);
+    CHECK(&*FrequencyOrder<int>(frequent).begin() == &*frequent.begin());
+
+    // Views over inline containers keep their copy inline, so they still never allocate.
+    Container<int, 8> small;
+    for (int x : {3, 1, 2}) {
+        small.add(x);
+    }
+    auto smallAsc = small | ascending;
+    auto smallCopy = smallAsc;
+    CHECK(&*smallCopy.begin() != &*smallAsc.begin());
+    CHECK(std::vector<int>(smallCopy.begin(), smallCopy.end()) == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("Top-k adaptors order only the requested elements") {
+    Container<int> c;
+    for (int i = 0; i < 50; ++i) {
+        c.add((i * 37) % 50);
+    }
+    auto low = c | smallest(3);
+    CHECK(std::vector<int>(low.begin(), low.end()) == std::vector<int>{0, 1, 2});
+    auto high = c | largest(4);
+    CHECK(std::vector<int>(high.begin(), high.end()) == std::vector<int>{49, 48, 47, 46});
+    CHECK((c | largest(100)).size() == 50);
+    CHECK((c | smallest(0)).empty());
+
+    Container<int> sorted;
+    sorted.add(1);
+    sorted.add(4);
+    sorted.add(9);
+    auto top = sorted | largest(2);
+    CHECK(&top.front() == &sorted.getData().back());
+    CHECK(top.back() == 4);
+}
+
+// ------------------ Streaming Tests ------------------
+
+namespace {
+
+Generator<int> countdown(int from) {
+    for (int i = from; i > 0; --i) {
+        co_yield i;
+    }
+}
+
+Generator<int> failingProducer() {
+    co_yield 1;
+    throw std::runtime_error("producer failed");
+}
+
+template <typename R>
+std::vector<int> drain(R&& range) {
+    std::vector<int> out;
+    for (int v : range) {
+        out.push_back(v);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("Generator yields lazily and is an input view") {
+    static_assert(std::ranges::input_range<Generator<int>>);
+    static_assert(std::ranges::view<Generator<int>>);
+    CHECK(drain(countdown(3)) == std::vector<int>{3, 2, 1});
+    CHECK(drain(countdown(0)).empty());
+
+    auto gen = countdown(2);
+    auto it = gen.begin();
+    ++it;
+    ++it;
+    CHECK(it == gen.end());
+    CHECK_THROWS_AS(*it, std::out_of_range);
+
+    CHECK_THROWS_AS(drain(failingProducer()), std::runtime_error);
+}
+
+TEST_CASE("Streaming orders over containers and producers") {
+    Container<int> c;
+    c.add(7);
+    c.add(15);
+    c.add(6);
+    c.add(1);
+    c.add(2);
+
+    CHECK(drain(streamOrder(Order<int>(c))) == std::vector<int>{7, 15, 6, 1, 2});
+    CHECK(drain(streamReverse(Order<int>(c), 5)) == std::vector<int>{2, 1, 6, 15, 7});
+    CHECK(drain(streamReverse(Order<int>(c), 2)) == std::vector<int>{15, 7, 1, 6, 2});
+    CHECK(drain(streamAscending(Order<int>(c), 2)) == std::vector<int>{1, 2, 6, 7, 15});
+    std::vector<int> upTo100(100);
+    std::iota(upTo100.begin(), upTo100.end(), 1);
+    CHECK(drain(streamAscending(countdown(100), 7)) == upTo100); // 15 spilled chunks, merged in passes
+    CHECK(drain(streamAscending(countdown(100) | std::views::take(3), 7)) == std::vector<int>{98, 99, 100});
+
+    CHECK_THROWS_AS(streamReverse(Order<int>(c), 0), std::invalid_argument);
+    CHECK_THROWS_AS(streamAscending(Order<int>(c), 0), std::invalid_argument);
+}
+
+// ------------------ External Sort Tests ------------------
+
+TEST_CASE("ExternalAscendingOrder keeps small inputs in memory") {
+    Container<int> c;
+    c.add(7);
+    c.add(15);
+    c.add(6);
+    c.add(1);
+    c.add(2);
+
+    ExternalAscendingOrder<int> ext(c);
+    CHECK(ext.size() == 5);
+    CHECK(ext.spilledRuns() == 0);
+    CHECK(drain(ext) == std::vector<int>{1, 2, 6, 7, 15});
+}
+
+TEST_CASE("ExternalAscendingOrder spills, merges in passes and cleans up") {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "mycontainers-external-sort-test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    ExternalSortConfig cfg;
+    cfg.directory = dir;
+    cfg.memoryBudget = 16 * sizeof(int); // 16 elements per run
+    cfg.blockSize = 4 * sizeof(int);     // merge fan-in of 4
+
+    std::vector<int> expected;
+    {
+        ExternalAscendingOrder<int> ext(countdown(1000), cfg);
+        CHECK(ext.size() == 1000);
+        CHECK(ext.spilledRuns() > 0);
+        CHECK(ext.spilledRuns() <= 4);
+        CHECK(std::distance(fs::directory_iterator(dir), fs::directory_iterator()) == static_cast<long>(ext.spilledRuns()));
+
+        std::vector<int> result = drain(ext);
+        for (int i = 1; i <= 1000; ++i) expected.push_back(i);
+        CHECK(result == expected);
+        CHECK(drain(ext) == expected); // a second pass restarts the merge
+    }
+    CHECK(fs::is_empty(dir));
+    fs::remove_all(dir);
+
+    cfg.memoryBudget = 1;
+    CHECK_THROWS_AS(ExternalAscendingOrder<int>(countdown(3), cfg), std::invalid_argument);
+}
+
+TEST_CASE("ExternalAscendingOrder reports unreadable runs instead of truncating") {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "mycontainers-external-sort-read-test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    // Reading a directory fails with an I/O error (badbit), not with end of file.
+    CHECK_THROWS_AS(detail::RunReader<int>(dir, 4), std::runtime_error);
+
+    ExternalSortConfig cfg;
+    cfg.directory = dir;
+    cfg.memoryBudget = 64 * sizeof(int);
+    cfg.blockSize = 4 * sizeof(int);
+    {
+        ExternalAscendingOrder<int> ext(countdown(100), cfg);
+        REQUIRE(ext.spilledRuns() == 2);
+        fs::path run = fs::directory_iterator(dir)->path();
+        fs::resize_file(run, fs::file_size(run) - 1); // a torn last element
+        CHECK_THROWS_AS(drain(ext), std::runtime_error);
+    }
+    fs::remove_all(dir);
+}
+
+TEST_CASE("ExternalAscendingOrder looks up the temp directory only when it spills") {
+    const char* saved = std::getenv("TMPDIR");
+    std::string previous = saved ? saved : "";
+    setenv("TMPDIR", "/nonexistent/mycontainers-tmp", 1);
+
+    Container<int> c;
+    for (int x : {3, 1, 2}) {
+        c.add(x);
+    }
+    std::vector<int> result;
+    CHECK_NOTHROW(result = drain(ExternalAscendingOrder<int>(c)));
+
+    if (saved) {
+        setenv("TMPDIR", previous.c_str(), 1);
+    } else {
+        unsetenv("TMPDIR");
+    }
+    CHECK(result == std::vector<int>{1, 2, 3});
+}
+
+// ------------------ SegmentedContainer Tests ------------------
+
+TEST_CASE("SegmentedContainer appends without moving elements") {
+    SegmentedContainer<int, 4> c;
+    c.add(0);
+    const int* first = &*c.begin();
+    for (int i = 1; i < 10; ++i) {
+        c.add(i);
+    }
+    CHECK(&*c.begin() == first);
+    CHECK(c.size() == 10);
+    CHECK(c.chunkCount() == 3);
+    CHECK(c.chunk(2).size() == 2);
+    CHECK_THROWS_AS(c.chunk(3), std::out_of_range);
+
+    std::vector<int> result(c.begin(), c.end());
+    CHECK(result == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    CHECK(c.begin()[7] == 7);
+}
+
+TEST_CASE("SegmentedContainer remove compacts across chunks") {
+    SegmentedContainer<std::string, 2> c;
+    c.add("a");
+    c.add("b");
+    c.add("a");
+    c.add("c");
+    c.add("a");
+    CHECK(c.count("a") == 3);
+    c.remove("a");
+    CHECK(c.size() == 2);
+    CHECK(c.chunkCount() == 1);
+    CHECK_FALSE(c.contains("a"));
+    CHECK_THROWS_AS(c.remove("a"), std::runtime_error);
+
+    std::ostringstream oss;
+    oss << c;
+    CHECK(oss.str() == "[b, c]");
+
+    SegmentedContainer<std::string, 2> copy = c;
+    copy.add("d");
+    CHECK(c.size() == 2);
+    CHECK(copy.size() == 3);
+}
+
+TEST_CASE("SegmentedContainer is a random-access range for sorted traversals") {
+    static_assert(std::ranges::random_access_range<SegmentedContainer<int, 8>>);
+    SegmentedContainer<int, 8> c;
+    for (int i = 20; i > 0; --i) {
+        c.add(i);
+    }
+    std::vector<int> expected;
+    for (int i = 1; i <= 20; ++i) expected.push_back(i);
+    CHECK(drain(streamAscending(std::views::all(c), 8)) == expected);
+    CHECK(drain(ExternalAscendingOrder<int>(c)) == expected);
+}
+
+// ------------------ Small Buffer Tests ------------------
+
+TEST_CASE("SmallVector stays inline up to its capacity and spills beyond it") {
+    SmallVector<std::string, 2> v;
+    v.push_back("a");
+    v.push_back("b");
+    CHECK_FALSE(v.isHeap());
+    v.push_back(v.front()); // growth must not invalidate the pushed value
+    CHECK(v.isHeap());
+    CHECK(v == std::vector<std::string>{"a", "b", "a"});
+
+    v.insert(v.begin() + 1, "x");
+    v.erase(v.begin());
+    CHECK(v == std::vector<std::string>{"x", "b", "a"});
+
+    SmallVector<std::string, 2> moved = std::move(v);
+    CHECK(v.empty());
+    moved.pop_back();
+    moved.shrink_to_fit();
+    CHECK_FALSE(moved.isHeap());
+    CHECK(moved == std::vector<std::string>{"x", "b"});
+}
+
+namespace {
+
+/** @brief Counts its live instances; copying throws once the shared budget is used up. */
+struct Fragile {
+    static inline int live = 0;
+    static inline int copiesLeft = 1000;
+    int value;
+
+    explicit Fragile(int v) : value(v) { ++live; }
+    Fragile(const Fragile& other) : value(other.value) {
+        if (copiesLeft-- == 0) throw std::runtime_error("copy failed");
+        ++live;
+    }
+    Fragile(Fragile&& other) noexcept(false) : Fragile(static_cast<const Fragile&>(other)) {}
+    Fragile& operator=(const Fragile&) = default;
+    ~Fragile() { --live; }
+};
+
+} // namespace
+
+TEST_CASE("SmallVector cleans up when copying an element throws") {
+    using Fragiles = SmallVector<Fragile, 2>;
+    {
+        Fragiles v;
+        v.push_back(Fragile(1));
+        v.push_back(Fragile(2));
+        v.push_back(Fragile(3));
+        REQUIRE(v.isHeap());
+        CHECK(Fragile::live == 3);
+
+        // Copy construction into a fresh heap buffer fails on the second element.
+        Fragile::copiesLeft = 1;
+        CHECK_THROWS_AS(Fragiles{v}, std::runtime_error);
+        CHECK(Fragile::live == 3);
+        Fragile::copiesLeft = 3; // the third element spills, and moving the first two to the heap fails
+        CHECK_THROWS_AS(Fragiles(v.begin(), v.end()), std::runtime_error);
+        CHECK(Fragile::live == 3);
+
+        // Growth copies (the move may throw), so a failure leaves the vector untouched.
+        v.push_back(Fragile(4));
+        Fragile::copiesLeft = 2;
+        CHECK_THROWS_AS(v.push_back(Fragile(5)), std::runtime_error);
+        CHECK(v.size() == 4);
+        CHECK(v.back().value == 4);
+        CHECK(Fragile::live == 4);
+        Fragile::copiesLeft = 1000;
+    }
+    CHECK(Fragile::live == 0);
+}
+
+TEST_CASE("Container with inline capacity keeps small data and views off the heap") {
+    Container<int, 16> c;
+    for (int x : {7, 15, 6, 1, 2}) {
+        c.add(x);
+    }
+    CHECK_FALSE(c.getData().isHeap());
+    CHECK(c.min() == 1);
+    CHECK(c.select(2) == 6);
+
+    AscendingOrder asc(c);
+    CHECK(std::vector<int>(asc.begin(), asc.end()) == std::vector<int>{1, 2, 6, 7, 15});
+    DescendingOrder desc(c);
+    CHECK(std::vector<int>(desc.begin(), desc.end()) == std::vector<int>{15, 7, 6, 2, 1});
+    SideCrossOrder sco(c);
+    CHECK(std::vector<int>(sco.begin(), sco.end()) == std::vector<int>{1, 15, 2, 7, 6});
+    ReverseOrder rev(c);
+    CHECK(*rev.begin() == 2);
+
+    auto top = c | largest(2);
+    CHECK(std::vector<int>(top.begin(), top.end()) == std::vector<int>{15, 7});
+    static_assert(isRandomAccessView<AscendingOrder<int, 16>>);
+
+    std::ostringstream oss;
+    oss << c;
+    CHECK(oss.str() == "[7, 15, 6, 1, 2]");
+}
+
+TEST_CASE("Container with inline capacity falls back to the heap when it grows") {
+    Container<int, 4> c;
+    for (int i = 10; i > 0; --i) {
+        c.add(i);
+    }
+    CHECK(c.getData().isHeap());
+    c.buildSortedIndex();
+    c.remove(10);
+    CHECK(c.getSortedIndex() == std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+    Container<int, 4> copy = c;
+    copy.remove(1);
+    CHECK(c.size() == 9);
+    CHECK(copy.size() == 8);
+    CHECK(drain(ExternalAscendingOrder<int>(copy)) == std::vector<int>{2, 3, 4, 5, 6, 7, 8, 9});
+}
+
+// ------------------ Copy-On-Write Tests ------------------
+
+TEST_CASE("Copies share storage until the first mutation") {
+    Container<int> original;
+    for (int x : {5, 3, 8}) {
+        original.add(x);
+    }
+    Container<int> snapshot = original;
+    CHECK(original.isShared());
+    CHECK(&snapshot.getData() == &original.getData());
+
+    original.add(1);
+    CHECK_FALSE(original.isShared());
+    CHECK_FALSE(snapshot.isShared());
+    CHECK(snapshot.getData() == std::vector<int>{5, 3, 8});
+    CHECK(original.getData() == std::vector<int>{5, 3, 8, 1});
+    CHECK(snapshot.min() == 3);
+    CHECK(original.min() == 1);
+    CHECK(snapshot.sum() == 16);
+}
+
+TEST_CASE("A failed remove on a shared copy does not clone it") {
+    Container<int> original;
+    for (int x : {5, 3, 8}) {
+        original.add(x);
+    }
+    Container<int> snapshot = original;
+    CHECK_THROWS_AS(snapshot.remove(7), std::runtime_error);
+    CHECK(snapshot.isShared());
+    CHECK(&snapshot.getData() == &original.getData());
+
+    snapshot.remove(3);
+    CHECK_FALSE(original.isShared());
+    CHECK(snapshot.getData() == std::vector<int>{5, 8});
+    CHECK(original.getData() == std::vector<int>{5, 3, 8});
+}
+
+TEST_CASE("Copy-on-write keeps views and indexes of the snapshot intact") {
+    Container<int> live;
+    for (int x : {4, 2, 6}) {
+        live.add(x);
+    }
+    live.buildSortedIndex();
+    Container<int> snapshot;
+    snapshot = live;
+    AscendingOrder<int> asc(snapshot);
+
+    live.remove(2);
+    live.add(9);
+    CHECK(std::vector<int>(asc.begin(), asc.end()) == std::vector<int>{2, 4, 6});
+    CHECK(snapshot.getSortedIndex() == std::vector<int>{2, 4, 6});
+    CHECK(live.getSortedIndex() == std::vector<int>{4, 6, 9});
+
+    CHECK_THROWS_AS(snapshot.remove(7), std::runtime_error);
+    CHECK(snapshot.size() == 3);
+
+    Container<int, 4> inlineCopy;
+    inlineCopy.add(1);
+    Container<int, 4> other = inlineCopy;
+    CHECK_FALSE(other.isShared());
+}
+
+// ------------------ PersistentContainer Tests ------------------
+
+TEST_CASE("PersistentContainer versions are immutable and share structure") {
+    std::vector<PersistentContainer<int>> versions{PersistentContainer<int>()};
+    for (int i = 0; i < 2000; ++i) {
+        versions.push_back(versions.back().add(i));
+    }
+    CHECK(versions[0].size() == 0);
+    CHECK(versions[1000].size() == 1000);
+    CHECK(versions[1000].at(999) == 999);
+    CHECK_THROWS_AS(versions[1000].at(1000), std::out_of_range);
+
+    // Elements committed to the trie are shared, not copied, by later versions.
+    CHECK(&versions[1000].at(10) == &versions[2000].at(10));
+    CHECK(&versions[1100].at(1050) == &versions[2000].at(1050));
+
+    std::vector<int> expected(2000);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(std::vector<int>(versions[2000].begin(), versions[2000].end()) == expected);
+    static_assert(std::ranges::random_access_range<PersistentContainer<int>>);
+}
+
+TEST_CASE("PersistentContainer remove returns a new version") {
+    PersistentContainer<int> v;
+    for (int i = 0; i < 100; ++i) {
+        v = v.add(i % 7);
+    }
+    PersistentContainer<int> removed = v.remove(3);
+    CHECK(v.count(3) == 14);
+    CHECK_FALSE(removed.contains(3));
+    CHECK(removed.size() == 86);
+    CHECK_THROWS_AS(removed.remove(3), std::runtime_error);
+
+    std::vector<int> expected;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 7 != 3) expected.push_back(i % 7);
+    }
+    CHECK(std::vector<int>(removed.begin(), removed.end()) == expected);
+    CHECK(removed.add(42).at(86) == 42);
+
+    PersistentContainer<int> w;
+    for (int i = 0; i < 100; ++i) {
+        w = w.add(i);
+    }
+    PersistentContainer<int> without70 = w.remove(70);
+    CHECK(&without70.at(63) == &w.at(63)); // leaves before the first match are shared
+    CHECK(without70.at(70) == 71);
+}
+
+TEST_CASE("Order views work on persistent versions") {
+    PersistentContainer<int> v = PersistentContainer<int>().add(7).add(15).add(6).add(1).add(2);
+    PersistentContainer<int> older = v.remove(15);
+
+    Container<int> flat = v.flat();
+    AscendingOrder<int> asc(flat);
+    CHECK(std::vector<int>(asc.begin(), asc.end()) == std::vector<int>{1, 2, 6, 7, 15});
+    auto desc = older | descending;
+    CHECK(std::vector<int>(desc.begin(), desc.end()) == std::vector<int>{7, 6, 2, 1});
+    auto top = v | smallest(2);
+    CHECK(std::vector<int>(top.begin(), top.end()) == std::vector<int>{1, 2});
+
+    // The view owns its flat copy: it outlives the version, and so do its copies.
+    auto inOrder = PersistentContainer<int>().add(3).add(1).add(2) | in_order;
+    auto copy = inOrder;
+    CHECK(drain(copy | std::views::take(2)) == std::vector<int>{3, 1});
+    CHECK((PersistentContainer<int>().add(5).add(5).add(4) | distinct).base().count(5) == 2);
+
+    std::ostringstream oss;
+    oss << older;
+    CHECK(oss.str() == "[7, 6, 1, 2]");
+}
+
+// ------------------ StableContainer Tests ------------------
+
+TEST_CASE("StableContainer erases single elements through handles") {
+    StableContainer<int> s;
+    Handle a = s.add(5);
+    Handle b = s.add(5);
+    Handle c = s.add(9);
+    CHECK(s.get(b) == 5);
+
+    s.erase(a);
+    CHECK(s.size() == 2);
+    CHECK(s.tombstones() == 1);
+    CHECK_FALSE(s.contains(a));
+    CHECK(s.contains(b));
+    CHECK_THROWS_AS(s.get(a), std::out_of_range);
+    CHECK_THROWS_AS(s.erase(a), std::out_of_range);
+
+    // The freed slot is reused with a new generation, so the old handle stays dead.
+    Handle d = s.add(1);
+    CHECK(d.slot == a.slot);
+    CHECK_FALSE(d == a);
+    CHECK_FALSE(s.contains(a));
+    CHECK(s.get(c) == 9);
+
+    std::ostringstream oss;
+    oss << s;
+    CHECK(oss.str() == "[5, 9, 1]");
+}
+
+TEST_CASE("StableContainer handles survive compaction and views skip erased elements") {
+    StableContainer<int> s;
+    s.setMaxDeadRatio(0.25);
+    std::vector<Handle> handles;
+    for (int i = 0; i < 8; ++i) {
+        handles.push_back(s.add(i * 10));
+    }
+    s.erase(handles[1]);
+    s.erase(handles[2]);
+    CHECK(s.tombstones() == 2);
+    s.erase(handles[4]); // 3 of 8 dead crosses the 0.25 ratio
+    CHECK(s.tombstones() == 0);
+    CHECK(s.get(handles[7]) == 70);
+    CHECK(s.get(handles[3]) == 30);
+
+    s.erase(handles[0]);
+    auto desc = s | descending;
+    CHECK(std::vector<int>(desc.begin(), desc.end()) == std::vector<int>{70, 60, 50, 30});
+    CHECK(s.tombstones() == 1); // views read through the bitmap instead of compacting
+    auto live = s.live();
+    static_assert(std::ranges::forward_range<decltype(live)> && std::ranges::sized_range<decltype(live)>);
+    CHECK(live.size() == 4);
+    CHECK(drain(live) == std::vector<int>{30, 50, 60, 70});
+    CHECK(s.snapshot().sum() == 210);
+    CHECK(drain(s | in_order | std::views::take(2)) == std::vector<int>{30, 50});
+
+    // Views keep the state they were built on.
+    s.erase(handles[5]);
+    CHECK(drain(live) == std::vector<int>{30, 50, 60, 70});
+    CHECK(drain(desc) == std::vector<int>{70, 60, 50, 30});
+    CHECK(drain(s.live()) == std::vector<int>{30, 60, 70});
+    CHECK_THROWS_AS(s.setMaxDeadRatio(0.0), std::invalid_argument);
+}
+
+TEST_CASE("Container removeMarked drops individual positions") {
+    Container<int> c;
+    for (int x : {4, 1, 4, 7, 2}) {
+        c.add(x);
+    }
+    c.buildSortedIndex();
+    CHECK(c.removeMarked({false, true, true, false, false}) == 2);
+    CHECK(c.getData() == std::vector<int>{4, 7, 2});
+    CHECK(c.getSortedIndex() == std::vector<int>{2, 4, 7});
+    CHECK(c.min() == 2);
+    CHECK(c.sum() == 13);
+    CHECK_THROWS_AS(c.removeMarked({true}), std::invalid_argument);
+}
+
+TEST_CASE("StableContainer remove defers compaction to the dead-ratio threshold") {
+    StableContainer<int> s;
+    Handle keep = s.add(3);
+    for (int i = 0; i < 9; ++i) {
+        s.add(i % 3 == 0 ? 1 : 2);
+    }
+    s.remove(1); // 3 of 10 dead, below the default 0.5 ratio: only tombstones
+    CHECK(s.tombstones() == 3);
+    CHECK(s.size() == 7);
+    CHECK_THROWS_AS(s.remove(1), std::runtime_error);
+    std::ostringstream oss;
+    oss << s;
+    CHECK(oss.str() == "[3, 2, 2, 2, 2, 2, 2]");
+
+    s.remove(2); // 9 of 10 dead crosses the ratio
+    CHECK(s.tombstones() == 0);
+    CHECK(s.size() == 1);
+    CHECK(s.get(keep) == 3);
+}
+
+TEST_CASE("StableContainer compacts on a background thread") {
+    StableContainer<int> s;
+    s.startBackgroundCompaction();
+    CHECK(s.compactsInBackground());
+    CHECK(s.live().empty());
+
+    std::vector<Handle> handles;
+    for (int i = 0; i < 1000; ++i) {
+        handles.push_back(s.add(i));
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        s.erase(handles[i]);
+    }
+    s.remove(1);
+
+    // live() and the views are safe to use while the worker may be compacting.
+    auto live = s.live();
+    CHECK(live.size() == 499);
+    CHECK(*live.begin() == 3);
+    CHECK(*(s | ascending).begin() == 3);
+    Container<int> snap = s.snapshot();
+    AscendingOrder<int> asc(snap);
+    CHECK(snap.size() == 499);
+    CHECK(*asc.begin() == 3);
+    CHECK(s.get(handles[999]) == 999);
+    CHECK_FALSE(s.contains(handles[1]));
+
+    // remove(1) crossed the dead ratio (501 of 1000), so the worker must compact.
+    REQUIRE(s.waitForCompaction(std::chrono::seconds(10)));
+    CHECK(s.tombstones() == 0);
+    CHECK(s.get(handles[999]) == 999); // handles survive the background pass
+    CHECK(live.size() == 499);         // and the earlier view is unaffected
+    auto compacted = s.live();
+    CHECK(std::vector<int>(live.begin(), live.end()) == std::vector<int>(compacted.begin(), compacted.end()));
+
+    s.stopBackgroundCompaction();
+    CHECK_FALSE(s.compactsInBackground());
+    CHECK(s.live().size() == 499);
+}
+
+// ------------------ EytzingerOrder Tests ------------------
+
+TEST_CASE("EytzingerOrder lays elements out in BFS order") {
+    Container<int> c;
+    for (int x : {7, 15, 6, 1, 2}) {
+        c.add(x);
+    }
+    EytzingerOrder<int> eyt(c);
+    CHECK(std::vector<int>(eyt.begin(), eyt.end()) == std::vector<int>{7, 2, 15, 1, 6});
+    CHECK(*eyt.lower_bound(3) == 6);
+    CHECK(*eyt.lower_bound(7) == 7);
+    CHECK(*eyt.lower_bound(-5) == 1);
+    CHECK(eyt.lower_bound(16) == nullptr);
+    CHECK(eyt.contains(15));
+    CHECK_FALSE(eyt.contains(5));
+
+    Container<int> empty;
+    EytzingerOrder<int> none(empty);
+    CHECK(none.begin() == none.end());
+    CHECK_FALSE(none.contains(1));
+    CHECK(none.lower_bound(1) == nullptr);
+}
+
+TEST_CASE("EytzingerOrder lower_bound agrees with std::lower_bound") {
+    std::mt19937 rng(11);
+    for (size_t n : {size_t(1), size_t(2), size_t(31), size_t(32), size_t(1000), size_t(4097)}) {
+        Container<int> c;
+        std::vector<int> sorted;
+        for (size_t i = 0; i < n; ++i) {
+            int x = static_cast<int>(rng() % 500);
+            c.add(x);
+            sorted.push_back(x);
+        }
+        std::sort(sorted.begin(), sorted.end());
+        auto eyt = c | eytzinger;
+        for (int probe = -1; probe <= 501; ++probe) {
+            auto expected = std::lower_bound(sorted.begin(), sorted.end(), probe);
+            auto found = eyt.lower_bound(probe);
+            if (expected == sorted.end()) {
+                CHECK(found == nullptr);
+            } else {
+                REQUIRE(found != nullptr);
+                CHECK(*found == *expected);
+            }
+            CHECK(eyt.contains(probe) == std::binary_search(sorted.begin(), sorted.end(), probe));
+        }
+    }
+}
+
+// ------------------ StaticBTree Tests ------------------
+
+TEST_CASE("StaticBTree answers rank and range queries") {
+    Container<int> c;
+    for (int x : {7, 15, 6, 1, 2, 7, 7}) {
+        c.add(x);
+    }
+    StaticBTree<int> tree(c);
+    CHECK(std::vector<int>(tree.begin(), tree.end()) == std::vector<int>{1, 2, 6, 7, 7, 7, 15});
+    CHECK(tree.size() == 7);
+    CHECK(tree.rank(7) == 3);
+    CHECK(tree.count(7) == 3);
+    CHECK(tree.count(5) == 0);
+    CHECK(*tree.lower_bound(3) == 6);
+    CHECK(*tree.upper_bound(7) == 15);
+    CHECK(tree.upper_bound(15) == tree.end());
+    auto [from, to] = tree.equal_range(7);
+    CHECK(to - from == 3);
+    CHECK(tree.contains(1));
+    CHECK_FALSE(tree.contains(8));
+    CHECK(tree.select(6) == 15);
+    CHECK_THROWS_AS(tree.select(7), std::out_of_range);
+
+    // The padding value itself must still be found and counted correctly.
+    c.add(std::numeric_limits<int>::max());
+    StaticBTree<int> withMax(c);
+    CHECK(withMax.contains(std::numeric_limits<int>::max()));
+    CHECK(withMax.count(std::numeric_limits<int>::max()) == 1);
+    CHECK(withMax.upper_bound(std::numeric_limits<int>::max()) == withMax.end());
+
+    Container<int> empty;
+    StaticBTree<int> none(empty);
+    CHECK(none.begin() == none.end());
+    CHECK(none.rank(3) == 0);
+    CHECK_FALSE(none.contains(3));
+}
+
+TEST_CASE("StaticBTree agrees with std::lower_bound and std::upper_bound") {
+    std::mt19937 rng(13);
+    for (simd::Isa isa : {simd::Isa::Scalar, simd::Isa::Avx2}) {
+        simd::setIsa(isa);
+        for (size_t n : {size_t(1), size_t(16), size_t(17), size_t(300), size_t(5000)}) {
+            Container<int> ints;
+            Container<float> floats;
+            std::vector<int> sorted;
+            for (size_t i = 0; i < n; ++i) {
+                int x = static_cast<int>(rng() % 700);
+                ints.add(x);
+                floats.add(static_cast<float>(x) / 2);
+                sorted.push_back(x);
+            }
+            std::sort(sorted.begin(), sorted.end());
+            StaticBTree<int> intTree(ints);
+            floats.buildSortedIndex();
+            StaticBTree<float> floatTree(floats);
+            for (int probe = -1; probe <= 701; ++probe) {
+                size_t lower = std::lower_bound(sorted.begin(), sorted.end(), probe) - sorted.begin();
+                size_t upper = std::upper_bound(sorted.begin(), sorted.end(), probe) - sorted.begin();
+                CHECK(intTree.rank(probe) == lower);
+                CHECK(intTree.upper_bound(probe) - intTree.begin() == static_cast<std::ptrdiff_t>(upper));
+                CHECK(floatTree.rank(static_cast<float>(probe) / 2) == lower);
+                CHECK(floatTree.count(static_cast<float>(probe) / 2) == upper - lower);
+            }
+        }
+    }
+    simd::setIsa(simd::Isa::Avx512);
+}
+
+// ------------------ Membership Filter Tests ------------------
+
+TEST_CASE("Container filter never rejects a present value and rejects most absent ones") {
+    Container<int> c;
+    for (int i = 0; i < 20000; i += 2) {
+        c.add(i);
+    }
+    CHECK_FALSE(c.hasFilter());
+    CHECK(c.maybe_contains(10));
+    CHECK_FALSE(c.maybe_contains(11)); // exact without a filter
+
+    c.buildFilter();
+    CHECK(c.hasFilter());
+    size_t falsePositives = 0;
+    for (int i = 0; i < 20000; ++i) {
+        if (i % 2 == 0) {
+            REQUIRE(c.maybe_contains(i));
+        } else if (c.maybe_contains(i)) {
+            ++falsePositives;
+        }
+    }
+    CHECK(falsePositives < 10000 / 50);
+    CHECK(c.contains(400));
+    CHECK_FALSE(c.contains(401));
+    CHECK(c.count(401) == 0);
+
+    // Growth past the planned capacity rebuilds the filter without losing values.
+    for (int i = 1; i < 100000; i += 2) {
+        c.add(i);
+    }
+    for (int i = 0; i < 20000; ++i) {
+        REQUIRE(c.maybe_contains(i));
+    }
+    CHECK_THROWS_AS(c.buildFilter(0), std::invalid_argument);
+    c.dropFilter();
+    CHECK_FALSE(c.hasFilter());
+    CHECK_FALSE(c.maybe_contains(-1));
+}
+
+TEST_CASE("Container filter stays correct across removals and short-circuits absent removes") {
+    Container<int> c;
+    for (int i = 0; i < 1000; ++i) {
+        c.add(i % 100);
+    }
+    c.buildFilter(16);
+    for (int v = 0; v < 80; ++v) {
+        c.remove(v); // stale bits pile up until the filter is rebuilt
+    }
+    CHECK(c.size() == 200);
+    for (int v = 80; v < 100; ++v) {
+        REQUIRE(c.maybe_contains(v));
+        CHECK(c.count(v) == 10);
+    }
+    for (int v = 0; v < 80; ++v) {
+        CHECK_FALSE(c.contains(v));
+    }
+
+    std::vector<bool> marked(c.size(), false);
+    marked[0] = true;
+    CHECK(c.removeMarked(marked) == 1);
+    CHECK(c.contains(80));
+
+    // A failed remove on a copy is rejected by the filter before the copy clones its contents.
+    Container<int> copy = c;
+    size_t rejected = 0;
+    for (int v = 1000; v < 1100; ++v) {
+        if (!copy.maybe_contains(v)) {
+            CHECK_THROWS_AS(copy.remove(v), std::runtime_error);
+            CHECK(copy.isShared());
+            ++rejected;
+        }
+    }
+    CHECK(rejected > 90);
+}
+
+namespace {
+
+/** @brief Ordered and printable, but with no std::hash specialization. */
+struct Point {
+    int x;
+    int y;
+    bool operator==(const Point&) const = default;
+    bool operator<(const Point& other) const { return x < other.x || (x == other.x && y < other.y); }
+    friend std::ostream& operator<<(std::ostream& os, const Point& p) { return os << p.x << ':' << p.y; }
+};
+
+/** @brief Ordered and printable, but not default-constructible. */
+class Label {
+    int id;
+
+public:
+    explicit Label(int id) : id(id) {}
+    bool operator==(const Label&) const = default;
+    bool operator<(const Label& other) const { return id < other.id; }
+    friend std::ostream& operator<<(std::ostream& os, const Label& l) { return os << '#' << l.id; }
+};
+
+} // namespace
+
+TEST_CASE("Container of a type without std::hash works without a filter") {
+    static_assert(!hashable<Point>);
+    Container<Point> c;
+    c.add({2, 1});
+    c.add({1, 5});
+    c.add({2, 1});
+    CHECK(c.contains({1, 5}));
+    CHECK(c.maybe_contains({2, 1}));
+    CHECK_FALSE(c.maybe_contains({3, 3}));
+    CHECK(c.count({2, 1}) == 2);
+    c.remove({2, 1});
+    CHECK(c.size() == 1);
+    CHECK_THROWS_AS(c.remove({2, 1}), std::runtime_error);
+    CHECK_FALSE(c.hasFilter());
+    std::ostringstream oss;
+    oss << c;
+    CHECK(oss.str() == "[1:5]");
+}
+
+TEST_CASE("Container of a type without a default constructor tracks its extrema") {
+    static_assert(!std::is_default_constructible_v<Label>);
+    Container<Label> c;
+    CHECK_THROWS_AS(c.min(), std::out_of_range);
+    for (int id : {4, 1, 9}) {
+        c.add(Label(id));
+    }
+    CHECK(c.min() == Label(1));
+    CHECK(c.max() == Label(9));
+    c.remove(Label(1));
+    c.remove(Label(9));
+    CHECK(c.min() == Label(4));
+    CHECK(c.max() == Label(4));
+    c.remove(Label(4));
+    CHECK_THROWS_AS(c.max(), std::out_of_range);
+}
+
+TEST_CASE("Container<bool> works through the generic paths") {
+    Container<bool> c;
+    for (bool b : {true, false, true, true}) {
+        c.add(b);
+    }
+    CHECK(c.count(true) == 3);
+    CHECK(c.contains(false));
+    CHECK(c.min() == false);
+    c.remove(false);
+    CHECK(c.size() == 3);
+    CHECK_FALSE(c.contains(false));
+    CHECK(c.min() == true);
+    CHECK_THROWS_AS(c.remove(false), std::runtime_error);
+
+    SegmentedContainer<bool, 2> segments;
+    for (bool b : {true, false, true}) {
+        segments.add(b);
+    }
+    CHECK(segments.count(true) == 2);
+    CHECK(segments.contains(false));
+}
+
+TEST_CASE("Container min and max are plain reads after a removal") {
+    Container<int> c;
+    for (int i = 0; i < 10000; ++i) {
+        c.add(i);
+    }
+    c.remove(0);
+    c.remove(9999);
+    // The removals repaired the extrema already, so concurrent const reads do not race.
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            if (c.min() != 1 || c.max() != 9998) ++wrong;
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    CHECK(wrong == 0);
+}
+
+// ------------------ DistinctOrder Tests ------------------
+
+TEST_CASE("DistinctOrder yields each value once, ascending, with counts") {
+    Container<int> c;
+    for (int x : {7, 1, 15, 7, 1, 2}) {
+        c.add(x);
+    }
+    DistinctOrder<int> d(c);
+    CHECK(drain(d) == std::vector<int>{1, 2, 7, 15});
+    CHECK(d.getCounts() == std::vector<size_t>{2, 1, 2, 1});
+    CHECK(d.count(7) == 2);
+    CHECK(d.count(3) == 0);
+    CHECK(d.countAt(3) == 1);
+    CHECK_THROWS_AS(d.countAt(4), std::out_of_range);
+
+    // Sorted index and already-sorted storage give the same answer without a sort.
+    c.buildSortedIndex();
+    CHECK(drain(c | distinct) == std::vector<int>{1, 2, 7, 15});
+    Container<int> sorted;
+    for (int x : {1, 1, 1, 4, 9, 9}) {
+        sorted.add(x);
+    }
+    auto ds = sorted | distinct | std::views::take(2);
+    CHECK(drain(ds) == std::vector<int>{1, 4});
+
+    Container<int> empty;
+    DistinctOrder<int> none(empty);
+    CHECK(none.begin() == none.end());
+    CHECK(none.count(1) == 0);
+}
+
+TEST_CASE("DistinctOrder first_seen keeps first-occurrence order") {
+    Container<int> c;
+    for (int x : {7, 1, 15, 7, 1, 2, 7}) {
+        c.add(x);
+    }
+    DistinctOrder<int> d(c, first_seen);
+    CHECK(drain(d) == std::vector<int>{7, 1, 15, 2});
+    CHECK(d.getCounts() == std::vector<size_t>{3, 2, 1, 1});
+    CHECK(d.count(7) == 3);
+    CHECK(d.count(8) == 0);
+    CHECK(d.size() == 4);
+}
+
+// ------------------ FrequencyOrder Tests ------------------
+
+TEST_CASE("FrequencyOrder yields (value, count) pairs by descending count") {
+    using Entry = std::pair<int, size_t>;
+    Container<int> c;
+    for (int x : {7, 1, 15, 7, 1, 7, 2}) {
+        c.add(x);
+    }
+    FrequencyOrder<int> f(c);
+    CHECK(std::vector<Entry>(f.begin(), f.end()) == std::vector<Entry>{{7, 3}, {1, 2}, {2, 1}, {15, 1}});
+    CHECK(f.isExact());
+    CHECK(f.errorAt(0) == 0);
+
+    auto top = c | most_frequent(2);
+    CHECK(std::vector<Entry>(top.begin(), top.end()) == std::vector<Entry>{{7, 3}, {1, 2}});
+
+    // The sorted-index path counts runs instead of hashing and must agree.
+    c.buildSortedIndex();
+    FrequencyOrder<int> viaIndex(c);
+    CHECK(std::vector<Entry>(viaIndex.begin(), viaIndex.end()) == std::vector<Entry>(f.begin(), f.end()));
+
+    Container<int> many;
+    std::mt19937 rng(3);
+    std::map<int, size_t> expected;
+    for (int i = 0; i < 50000; ++i) {
+        int x = static_cast<int>(rng() % 3000);
+        many.add(x);
+        ++expected[x];
+    }
+    FrequencyOrder<int> all(many);
+    CHECK(all.size() == expected.size());
+    for (const auto& [value, count] : all) {
+        REQUIRE(expected[value] == count);
+    }
+}
+
+TEST_CASE("FrequencyOrder space-saving mode finds the heavy hitters in bounded memory") {
+    Container<int> c;
+    std::mt19937 rng(9);
+    for (int i = 0; i < 20000; ++i) {
+        // Values 0..4 take about half the stream; the rest is spread over 10000 values.
+        c.add(i % 2 == 0 ? static_cast<int>(rng() % 5) : 100 + static_cast<int>(rng() % 10000));
+    }
+    FrequencyOrder<int> exact(c, 5);
+    FrequencyOrder<int> approx(c, SpaceSaving{64});
+    CHECK_FALSE(approx.isExact());
+    CHECK(approx.size() == 64);
+
+    std::vector<int> exactTop;
+    for (const auto& entry : exact) {
+        exactTop.push_back(entry.first);
+    }
+    std::vector<int> approxTop;
+    for (size_t i = 0; i < 5; ++i) {
+        const auto& [value, count] = approx[i];
+        approxTop.push_back(value);
+        CHECK(count >= c.count(value));
+        CHECK(count - approx.errorAt(i) <= c.count(value));
+    }
+    std::sort(exactTop.begin(), exactTop.end());
+    std::sort(approxTop.begin(), approxTop.end());
+    CHECK(approxTop == exactTop);
+    CHECK_THROWS_AS(FrequencyOrder<int>(c, SpaceSaving{0}), std::invalid_argument);
+}
+
+// ------------------ ShuffleOrder Tests ------------------
+
+TEST_CASE("ShuffleOrder is a reproducible permutation of the container") {
+    Container<int> c;
+    for (int x : {7, 15, 6, 1, 2}) {
+        c.add(x);
+    }
+    CHECK(drain(ShuffleOrder<int>(c, 1)) == std::vector<int>{6, 1, 2, 15, 7});
+    CHECK(drain(ShuffleOrder<int>(c, 1)) == drain(ShuffleOrder<int>(c, 1)));
+
+    for (size_t n : {size_t(0), size_t(1), size_t(2), size_t(17), size_t(1000), size_t(4096)}) {
+        Container<int> big;
+        for (size_t i = 0; i < n; ++i) {
+            big.add(static_cast<int>(i));
+        }
+        ShuffleOrder<int> shuffled(big, 99);
+        std::vector<int> order = drain(shuffled);
+        CHECK(shuffled.size() == n);
+        std::vector<int> sorted = order;
+        std::sort(sorted.begin(), sorted.end());
+        std::vector<int> expected(n);
+        std::iota(expected.begin(), expected.end(), 0);
+        CHECK(sorted == expected);
+    }
+}
+
+TEST_CASE("ShuffleOrder is random-access and depends on the seed") {
+    Container<int> c;
+    for (int i = 0; i < 1000; ++i) {
+        c.add(i);
+    }
+    ShuffleOrder<int> a(c, 7);
+    ShuffleOrder<int> b(c, 8);
+    static_assert(isRandomAccessView<ShuffleOrder<int>>);
+    CHECK(drain(a) != drain(b));
+    CHECK(a[500] == *(a.begin() + 500));
+
+    size_t fixedPoints = 0;
+    for (int i = 0; i < 1000; ++i) {
+        fixedPoints += a[i] == i;
+    }
+    CHECK(fixedPoints < 20); // a random permutation has about one
+
+    auto firstTen = a | std::views::take(10);
+    CHECK(std::ranges::distance(firstTen) == 10);
+}
+
+// ------------------ StridedOrder / SampleOrder Tests ------------------
+
+TEST_CASE("StridedOrder visits every stride-th element from the offset") {
+    Container<int> c;
+    for (int x : {7, 15, 6, 1, 2}) {
+        c.add(x);
+    }
+    CHECK(drain(StridedOrder<int>(c, 2)) == std::vector<int>{7, 6, 2});
+    CHECK(drain(StridedOrder<int>(c, 2, 1)) == std::vector<int>{15, 1});
+    CHECK(drain(StridedOrder<int>(c, 1)) == std::vector<int>{7, 15, 6, 1, 2});
+    CHECK(drain(StridedOrder<int>(c, 10, 4)) == std::vector<int>{2});
+    CHECK(StridedOrder<int>(c, 3, 5).empty());
+    CHECK_THROWS_AS(StridedOrder<int>(c, 0), std::invalid_argument);
+
+    StridedOrder<int> s(c, 2);
+    static_assert(isRandomAccessView<StridedOrder<int>>);
+    CHECK(s.size() == 3);
+    CHECK(s[2] == 2);
+    CHECK(*(s.end() - 1) == 2);
+}
+
+TEST_CASE("SampleOrder draws k distinct elements in container order") {
+    Container<int> c;
+    for (int i = 0; i < 10000; ++i) {
+        c.add(i);
+    }
+    SampleOrder<int> sample(c, 100, 5);
+    std::vector<int> drawn = drain(sample);
+    CHECK(drawn.size() == 100);
+    CHECK(std::is_sorted(drawn.begin(), drawn.end()));
+    CHECK(std::adjacent_find(drawn.begin(), drawn.end()) == drawn.end());
+    CHECK(drain(SampleOrder<int>(c, 100, 5)) == drawn);
+    CHECK(drain(SampleOrder<int>(c, 100, 6)) != drawn);
+    CHECK(sample.getIndices()[0] == static_cast<size_t>(drawn[0]));
+
+    // Every position should be about equally likely to be drawn.
+    Container<int> small;
+    for (int i = 0; i < 10; ++i) {
+        small.add(i);
+    }
+    std::vector<int> hits(10, 0);
+    for (uint64_t seed = 0; seed < 3000; ++seed) {
+        for (int x : SampleOrder<int>(small, 3, seed)) {
+            ++hits[x];
+        }
+    }
+    for (int h : hits) {
+        CHECK(h > 750);
+        CHECK(h < 1050); // expected 900
+    }
+
+    CHECK(drain(SampleOrder<int>(small, 50, 1)) == drain(Order<int>(small)));
+    Container<int> empty;
+    CHECK(SampleOrder<int>(empty, 3, 1).empty());
+}
+
+// ------------------ Chunked Iteration Tests ------------------
+
+namespace {
+
+/** @brief Concatenates the chunks for_each_chunk hands out, recording their sizes. */
+template <typename View>
+std::vector<int> collectChunks(const View& view, size_t chunkSize, std::vector<size_t>& sizes) {
+    std::vector<int> out;
+    for_each_chunk(view, chunkSize, [&](std::span<const int> chunk) {
+        sizes.push_back(chunk.size());
+        out.insert(out.end(), chunk.begin(), chunk.end());
+    });
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("for_each_chunk hands out spans straight from contiguous storage") {
+    Container<int> c;
+    for (int i = 0; i < 10; ++i) {
+        c.add((i * 7) % 10);
+    }
+    std::vector<const int*> starts;
+    std::vector<size_t> sizes;
+    for_each_chunk(Order<int>(c), 4, [&](std::span<const int> chunk) {
+        starts.push_back(chunk.data());
+        sizes.push_back(chunk.size());
+    });
+    CHECK(sizes == std::vector<size_t>{4, 4, 2});
+    CHECK(starts == std::vector<const int*>{c.getData().data(), c.getData().data() + 4, c.getData().data() + 8});
+
+    sizes.clear();
+    CHECK(collectChunks(c | ascending, 3, sizes) == drain(c | ascending));
+    sizes.clear();
+    CHECK(collectChunks(c | middle_out, 3, sizes) == drain(c | middle_out));
+    sizes.clear();
+    CHECK(collectChunks(c | side_cross, 100, sizes) == drain(c | side_cross));
+    CHECK(sizes == std::vector<size_t>{10});
+
+    Container<int> empty;
+    size_t calls = 0;
+    for_each_chunk(Order<int>(empty), 4, [&](std::span<const int>) { ++calls; });
+    CHECK(calls == 0);
+    CHECK_THROWS_AS(for_each_chunk(Order<int>(c), 0, [](std::span<const int>) {}), std::invalid_argument);
+}
+
+TEST_CASE("for_each_chunk stages computed orders through a reused buffer") {
+    Container<int> c;
+    for (int i = 0; i < 11; ++i) {
+        c.add((i * 5) % 11);
+    }
+    std::vector<size_t> sizes;
+    CHECK(collectChunks(c | reversed, 4, sizes) == drain(c | reversed));
+    CHECK(sizes == std::vector<size_t>{4, 4, 3});
+    sizes.clear();
+    CHECK(collectChunks(c | descending, 5, sizes) == drain(c | descending));
+    sizes.clear();
+    CHECK(collectChunks(ShuffleOrder<int>(c, 3), 2, sizes) == drain(ShuffleOrder<int>(c, 3)));
+    sizes.clear();
+    CHECK(collectChunks(StridedOrder<int>(c, 3, 1), 2, sizes) == drain(StridedOrder<int>(c, 3, 1)));
+    sizes.clear();
+    auto pipeline = c | ascending | std::views::take(7);
+    CHECK(collectChunks(pipeline, 3, sizes) == drain(pipeline));
+    CHECK(sizes == std::vector<size_t>{3, 3, 1});
+
+    std::vector<const int*> starts;
+    for_each_chunk(c | reversed, 4, [&](std::span<const int> chunk) { starts.push_back(chunk.data()); });
+    CHECK(starts[0] == starts[1]); // one staging buffer for every chunk
+}
+
+TEST_CASE("for_each_chunk accepts views that only iterate non-const") {
+    Container<int> c;
+    for (int i = 0; i < 10; ++i) {
+        c.add(i);
+    }
+    auto even = [](int x) { return x % 2 == 0; };
+    std::vector<int> out;
+    std::vector<size_t> sizes;
+    for_each_chunk(c | reversed | std::views::filter(even), 2, [&](std::span<const int> chunk) {
+        sizes.push_back(chunk.size());
+        out.insert(out.end(), chunk.begin(), chunk.end());
+    });
+    CHECK(out == std::vector<int>{8, 6, 4, 2, 0});
+    CHECK(sizes == std::vector<size_t>{2, 2, 1});
+
+    auto filtered = c | ascending | std::views::filter(even);
+    out.clear();
+    for_each_chunk(filtered, 4, [&](std::span<const int> chunk) { out.insert(out.end(), chunk.begin(), chunk.end()); });
+    CHECK(out == std::vector<int>{0, 2, 4, 6, 8});
+}
+
+// ------------------ ThreadPool / Parallel Tests ------------------
+
+TEST_CASE("ThreadPool runs tasks and forwards results and exceptions") {
+    ThreadPool pool(3);
+    CHECK(pool.size() == 3);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 20; ++i) {
+        results.push_back(pool.submit([i] { return i * i; }));
+    }
+    for (int i = 0; i < 20; ++i) {
+        CHECK(results[i].get() == i * i);
+    }
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    CHECK_THROWS_AS(failing.get(), std::runtime_error);
+    CHECK_THROWS_AS(ThreadPool(0), std::invalid_argument);
+}
+
+TEST_CASE("split partitions a view into balanced sub-ranges") {
+    Container<int> c;
+    for (int i = 0; i < 10; ++i) {
+        c.add(i);
+    }
+    auto parts = split(c | reversed, 3);
+    REQUIRE(parts.size() == 3);
+    CHECK(drain(parts[0]) == std::vector<int>{9, 8, 7, 6});
+    CHECK(drain(parts[1]) == std::vector<int>{5, 4, 3});
+    CHECK(drain(parts[2]) == std::vector<int>{2, 1, 0});
+    CHECK(split(c | ascending, 12)[11].empty());
+    CHECK_THROWS_AS(split(c | ascending, 0), std::invalid_argument);
+}
+
+TEST_CASE("parallel_reduce and parallel_for_each agree with sequential loops") {
+    Container<int> c;
+    std::mt19937 rng(17);
+    for (int i = 0; i < 100000; ++i) {
+        c.add(static_cast<int>(rng() % 1000));
+    }
+    long long expected = c.sum();
+    for (size_t threads : {size_t(1), size_t(3)}) {
+        ThreadPool pool(threads);
+        CHECK(parallel_reduce(Order<int>(c), 0LL, std::plus<>(), std::identity(), pool) == expected);
+        CHECK(parallel_reduce(c | descending, 0LL, std::plus<>(), std::identity(), pool) == expected);
+        CHECK(parallel_reduce(ShuffleOrder<int>(c, 4), 0LL, std::plus<>(), std::identity(), pool) == expected);
+        CHECK(parallel_reduce(c | middle_out, 0LL, std::plus<>(),
+                              [](int x) { return static_cast<long long>(x) * x; }, pool) ==
+              std::accumulate(c.getData().begin(), c.getData().end(), 0LL,
+                              [](long long acc, int x) { return acc + static_cast<long long>(x) * x; }));
+
+        // Associative but not commutative: the parts must be combined in view order.
+        auto prefix = c | ascending | std::views::take(90000);
+        std::vector<int> concatenated = parallel_reduce(prefix, std::vector<int>{},
+            [](std::vector<int> a, const std::vector<int>& b) {
+                a.insert(a.end(), b.begin(), b.end());
+                return a;
+            },
+            [](int x) { return std::vector<int>{x}; }, pool);
+        CHECK(concatenated == drain(prefix));
+
+        std::atomic<long long> total{0};
+        std::atomic<size_t> visited{0};
+        parallel_for_each(c | reversed, [&](int x) {
+            total += x;
+            ++visited;
+        }, pool);
+        CHECK(total == expected);
+        CHECK(visited == c.size());
+
+        CHECK_THROWS_AS(parallel_for_each(Order<int>(c), [](int x) {
+            if (x == 999) throw std::runtime_error("stop");
+        }, pool), std::runtime_error);
+    }
+    CHECK(parallel_reduce(Order<int>(c), 0LL) == expected);
+}
+
+TEST_CASE("parallel algorithms can be nested on the same pool") {
+    Container<int> c;
+    for (int i = 0; i < 40000; ++i) {
+        c.add(i);
+    }
+    long long expected = c.sum();
+    auto nestedCalls = [&](ThreadPool& pool) {
+        // The worker's part calls back into the pool and waits on it.
+        std::atomic<int> nested{0};
+        parallel_for_each(Order<int>(c), [&](int x) {
+            if (x % 10000 == 0 &&
+                parallel_reduce(Order<int>(c), 0LL, std::plus<>(), std::identity(), pool) == expected) {
+                ++nested;
+            }
+        }, pool);
+        return nested.load();
+    };
+    ThreadPool single(1);
+    CHECK(nestedCalls(single) == 4);
+    CHECK(nestedCalls(ThreadPool::shared()) == 4);
+}